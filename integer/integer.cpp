@@ -7,564 +7,3752 @@
 #include <cassert>
 #include <stdexcept>
 #include <cstdint>
+#include <thread>
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <sstream>
+#include <array>
+#include <cmath>
+#include <atomic>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+	#include <immintrin.h>
+	#define INTEGER_X86_SIMD	// <- SIMD batch kernels are available and selected at runtime
+#endif
+
+//Initializes the random engine
+std::default_random_engine Integer::_random_engine(
+									std::chrono::system_clock::now().time_since_epoch().count());
+
+//Initializes the max number of threads to the available hardware threads
+size_t Integer::_n_threads = MAX(std::thread::hardware_concurrency(), 1u);
+
+//Initializes the growth factor of the words capacity to its default value
+double Integer::_growth_factor = DEFAULT_GROWTH_FACTOR;
+
+//Initializes the algorithm thresholds to their default values
+Integer::Thresholds Integer::_thresholds;
+
+/////	Number Theoretic Transform helpers /////
+
+/**
+	*	NTT primes. Every prime has the form c*2^k + 1 with k >= 23 and 3 as
+	*	primitive root. The product of the three primes (~2^86) bounds the
+	*	convolution coefficients of two 2^22 words operands of 31 bits.
+*/
+#define NTT_P1 998244353u
+#define NTT_P2 167772161u
+#define NTT_P3 469762049u
+#define NTT_MAX_LOG 23
+
+/**
+	*	@brief Runs f(lo, hi) over [begin, end) split into contiguous chunks, one
+	*	per thread. The calling thread computes the last chunk. Exceptions thrown
+	*	by any chunk are rethrown once every thread is joined, the first chunk
+	*	first.
+*/
+template <class F>
+static void parallel_for(size_t begin, size_t end, size_t n_threads, const F & f) {
+
+	n_threads = MIN(n_threads, end - begin);
+
+	if (n_threads <= 1) {
+		f(begin, end);
+		return;
+	}
+
+	std::vector<std::thread> workers;
+	std::vector<std::exception_ptr> errors(n_threads);
+	const size_t chunk = (end - begin) / n_threads;
+	const size_t rest = (end - begin) % n_threads;
+	size_t lo = begin;
+
+	//Runs the chunk t, keeping its exception
+	auto run = [&f, &errors](size_t i, size_t from, size_t to) {
+		try {
+			f(from, to);
+		}
+		catch (...) {
+			errors[i] = std::current_exception();
+		}
+	};
+
+	size_t t = 0;
+
+	workers.reserve(n_threads - 1);
+
+	try {
+		for (; t < n_threads - 1; t++) {
+			const size_t hi = lo + chunk + (t < rest);
+			workers.emplace_back(run, t, lo, hi);
+			lo = hi;
+		}
+	}
+	catch (...) {
+		//A thread could not be started, the calling thread takes its chunks.
+		//Started workers are joined below, whatever happens to the chunks
+	}
+
+	run(t, lo, end);
+
+	for (std::thread & worker : workers)
+		worker.join();
+
+	for (const std::exception_ptr & error : errors)
+		if (error)
+			std::rethrow_exception(error);
+}
+
+/**
+	*	@brief Computes b^e mod p
+*/
+static uint32_t pow_mod(uint64_t b, uint64_t e, uint32_t p) {
+	uint64_t r = 1;
+	b %= p;
+
+	while (e > 0) {
+		if (e & 1)
+			r = r * b % p;
+		b = b * b % p;
+		e >>= 1;
+	}
+
+	return (uint32_t)r;
+}
+
+/**
+	*	@brief Fills the twiddle table for a n points transform. Powers of the
+	*	2*len-th root of unity are stored contiguously at roots[len..2*len) so
+	*	every stage reads its twiddles sequentially.
+*/
+template <uint32_t P>
+static void ntt_roots(std::vector<uint32_t> & roots, size_t n, bool inverse) {
+
+	roots.resize(MAX(n, (size_t)2));
+
+	for (size_t len = 1; len < n; len <<= 1) {
+		uint64_t w = pow_mod(3, (P - 1) / (2 * len), P);
+		if (inverse)
+			w = pow_mod(w, P - 2, P);
+
+		uint64_t aux = 1;
+		for (size_t j = 0; j < len; j++) {
+			roots[len + j] = (uint32_t)aux;
+			aux = aux * w % P;
+		}
+	}
+}
+
+/**
+	*	@brief Decimation in frequency butterflies j in [j_lo, j_hi) of a 2*len
+	*	points block.
+*/
+template <uint32_t P>
+static inline void ntt_dif_butterflies(uint32_t * a, size_t len, const uint32_t * w,
+																				size_t j_lo, size_t j_hi) {
+	for (size_t j = j_lo; j < j_hi; j++) {
+		const uint32_t u = a[j], v = a[j + len];
+		const uint32_t s = u + v;
+
+		a[j] = s >= P? s - P : s;
+		a[j + len] = (uint64_t)(u + P - v) * w[j] % P;
+	}
+}
+
+/**
+	*	@brief Decimation in time butterflies j in [j_lo, j_hi) of a 2*len
+	*	points block.
+*/
+template <uint32_t P>
+static inline void ntt_dit_butterflies(uint32_t * a, size_t len, const uint32_t * w,
+																				size_t j_lo, size_t j_hi) {
+	for (size_t j = j_lo; j < j_hi; j++) {
+		const uint32_t u = a[j];
+		const uint32_t v = (uint64_t)a[j + len] * w[j] % P;
+		const uint32_t s = u + v;
+
+		a[j] = s >= P? s - P : s;
+		a[j + len] = u >= v? u - v : u + P - v;
+	}
+}
+
+/**
+	*	@brief Runs the butterflies of a whole stage with flat indexes in
+	*	[lo, hi). Used for the stages whose blocks do not fit into the cache, so
+	*	the stage can be split across threads whatever its block length is.
+*/
+template <uint32_t P, bool DIF>
+static void ntt_stage(uint32_t * a, size_t len, const uint32_t * roots, size_t lo, size_t hi) {
+
+	while (lo < hi) {
+		const size_t block = lo / len;
+		const size_t j = lo % len;
+		const size_t j_end = MIN(len, j + (hi - lo));
+
+		if (DIF)
+			ntt_dif_butterflies<P>(a + 2 * block * len, len, roots + len, j, j_end);
+		else
+			ntt_dit_butterflies<P>(a + 2 * block * len, len, roots + len, j, j_end);
+
+		lo += j_end - j;
+	}
+}
+
+/**
+	*	@brief Forward transform (natural order to bit-reversed order).
+	*
+	*	Stages spanning more than the ntt_block threshold points are split across threads by
+	*	butterflies. Once the stages fit into a block, every block is
+	*	independent and is completely transformed by a single thread while it
+	*	remains in the cache.
+*/
+template <uint32_t P>
+static void ntt_forward(uint32_t * a, size_t n, const std::vector<uint32_t> & roots,
+																												size_t n_threads) {
+	const size_t block = MIN(n, Integer::get_thresholds().ntt_block);
+	size_t len = n >> 1;
+
+	for (; 2 * len > block; len >>= 1)
+		parallel_for(0, n >> 1, n_threads, [&](size_t lo, size_t hi) {
+			ntt_stage<P, true>(a, len, roots.data(), lo, hi);
+		});
+
+	parallel_for(0, n / block, n_threads, [&](size_t lo, size_t hi) {
+		for (size_t b = lo; b < hi; b++)
+			for (size_t l = len; l > 0; l >>= 1)
+				for (size_t s = 0; s < block; s += 2 * l)
+					ntt_dif_butterflies<P>(a + b * block + s, l, roots.data() + l, 0, l);
+	});
+}
+
+/**
+	*	@brief Inverse transform without the 1/n scaling (bit-reversed order to
+	*	natural order). Blocking is the mirror of ntt_forward.
+*/
+template <uint32_t P>
+static void ntt_inverse(uint32_t * a, size_t n, const std::vector<uint32_t> & roots,
+																												size_t n_threads) {
+	const size_t block = MIN(n, Integer::get_thresholds().ntt_block);
+
+	parallel_for(0, n / block, n_threads, [&](size_t lo, size_t hi) {
+		for (size_t b = lo; b < hi; b++)
+			for (size_t l = 1; 2 * l <= block; l <<= 1)
+				for (size_t s = 0; s < block; s += 2 * l)
+					ntt_dit_butterflies<P>(a + b * block + s, l, roots.data() + l, 0, l);
+	});
+
+	for (size_t len = block; len < n; len <<= 1)
+		parallel_for(0, n >> 1, n_threads, [&](size_t lo, size_t hi) {
+			ntt_stage<P, false>(a, len, roots.data(), lo, hi);
+		});
+}
+
+/**
+	*	@brief Computes the cyclic convolution of a and b modulo P on n points and
+	*	stores it into r. b is ignored on squaring.
+*/
+template <uint32_t P>
+static void ntt_convolution(std::vector<uint32_t> & r, const int32_t * a, size_t na,
+														const int32_t * b, size_t nb, size_t n, bool square,
+														size_t n_threads) {
+	std::vector<uint32_t> roots, fb;
+
+	r.assign(n, 0);
+	parallel_for(0, na, n_threads, [&](size_t lo, size_t hi) {
+		for (size_t i = lo; i < hi; i++)
+			r[i] = (uint32_t)a[i] % P;
+	});
+
+	ntt_roots<P>(roots, n, false);
+	ntt_forward<P>(r.data(), n, roots, n_threads);
+
+	if (!square) {
+		fb.assign(n, 0);
+		parallel_for(0, nb, n_threads, [&](size_t lo, size_t hi) {
+			for (size_t i = lo; i < hi; i++)
+				fb[i] = (uint32_t)b[i] % P;
+		});
+
+		ntt_forward<P>(fb.data(), n, roots, n_threads);
+	}
+
+	// Pointwise product, scaled by 1/n in advance for the inverse transform
+	const uint64_t n_inv = pow_mod(n, P - 2, P);
+	const uint32_t * f = square? r.data() : fb.data();
+
+	parallel_for(0, n, n_threads, [&](size_t lo, size_t hi) {
+		for (size_t i = lo; i < hi; i++)
+			r[i] = (uint64_t)r[i] * f[i] % P * n_inv % P;
+	});
+
+	ntt_roots<P>(roots, n, true);
+	ntt_inverse<P>(r.data(), n, roots, n_threads);
+}
+
+/**
+	*	@brief Multiplies the positive words sequences a and b (31 bits words) by
+	*	three primes NTT and stores the na+nb words of the product into r.
+*/
+static void ntt_multiply(int32_t * r, const int32_t * a, size_t na,
+													const int32_t * b, size_t nb, size_t n_threads) {
+
+	const size_t length = na + nb - 1;
+	size_t n = 1;
+
+	while (n < length)
+		n <<= 1;
+
+	#ifdef DEBUG
+		assert(n <= ((size_t)1 << NTT_MAX_LOG));
+	#endif
+
+	if (n < Integer::get_thresholds().ntt_parallel)
+		n_threads = 1;
+
+	const bool square = a == b && na == nb;
+	std::vector<uint32_t> c1, c2, c3;
+
+	ntt_convolution<NTT_P1>(c1, a, na, b, nb, n, square, n_threads);
+	ntt_convolution<NTT_P2>(c2, a, na, b, nb, n, square, n_threads);
+	ntt_convolution<NTT_P3>(c3, a, na, b, nb, n, square, n_threads);
+
+	// Garner constants for the CRT reconstruction
+	const uint64_t p1_inv_p2 = pow_mod(NTT_P1, NTT_P2 - 2, NTT_P2);
+	const uint64_t p1p2_inv_p3 = pow_mod((uint64_t)NTT_P1 * NTT_P2 % NTT_P3,
+																																NTT_P3 - 2, NTT_P3);
+	const unsigned __int128 p1p2 = (unsigned __int128)NTT_P1 * NTT_P2;
+
+	/* CRT and carry propagation are computed by chunks in parallel, every chunk
+	 * starting with no carry. The carries leaving every chunk are added
+	 * afterwards in order. */
+	const size_t size = na + nb;
+	const size_t n_chunks = MIN(n_threads, size);
+	std::vector<unsigned __int128> carries(n_chunks);
+
+	parallel_for(0, n_chunks, n_chunks, [&](size_t c_lo, size_t c_hi) {
+		for (size_t c = c_lo; c < c_hi; c++) {
+			const size_t lo = size * c / n_chunks, hi = size * (c + 1) / n_chunks;
+			unsigned __int128 carry = 0;
+
+			for (size_t i = lo; i < hi; i++) {
+
+				if (i < length) {
+					const uint64_t x1 = c1[i];
+					const uint64_t x2 = (c2[i] + NTT_P2 - x1 % NTT_P2) * p1_inv_p2 % NTT_P2;
+					const uint64_t aux = (x1 + x2 * NTT_P1) % NTT_P3;
+					const uint64_t x3 = (c3[i] + NTT_P3 - aux) * p1p2_inv_p3 % NTT_P3;
+
+					carry += x1 + (unsigned __int128)x2 * NTT_P1 + x3 * p1p2;
+				}
+
+				r[i] = (int32_t)(carry & 0x7fffffff);
+				carry >>= 31;
+			}
+
+			carries[c] = carry;
+		}
+	});
+
+	for (size_t c = 0; c < n_chunks; c++) {
+		unsigned __int128 carry = carries[c];
+
+		for (size_t i = size * (c + 1) / n_chunks; carry != 0 && i < size; i++) {
+			carry += r[i];
+			r[i] = (int32_t)(carry & 0x7fffffff);
+			carry >>= 31;
+		}
+	}
+}
+
+/////	Schoolbook multiplication helpers /////
+
+/**
+	*	@brief Schoolbook product of the positive words sequences a and b (31
+	*	bits words). Writes the na+nb words of the product into r.
+*/
+static void mul_basecase(int32_t * r, const int32_t * a, size_t na,
+													const int32_t * b, size_t nb) {
+
+	std::fill(r, r + na + nb, 0);
+
+	for (size_t i = 0; i < na; i++) {
+		uint64_t carry = 0;
+
+		for (size_t j = 0; j < nb; j++) {
+			carry += (uint64_t)r[i + j] + (uint64_t)a[i] * (uint64_t)b[j];
+			r[i + j] = (int32_t)(carry & 0x7fffffff);
+			carry >>= 31;
+		}
+
+		r[i + nb] = (int32_t)carry;
+	}
+}
+
+/////	Words arithmetic helpers /////
+
+/**
+	*	@brief Adds the positive words sequences a and b (na >= nb) and writes the
+	*	na words of the sum into r. r may be a.
+	*	@return Carry out of the word na-1.
+*/
+static int32_t add_words(int32_t * r, const int32_t * a, size_t na,
+													const int32_t * b, size_t nb) {
+
+	uint32_t carry = 0;
+	size_t i;
+
+	for (i = 0; i < nb; i++) {
+		const uint32_t t = (uint32_t)a[i] + (uint32_t)b[i] + carry;
+		r[i] = (int32_t)(t & 0x7fffffff);
+		carry = t >> 31;
+	}
+
+	for (; i < na && carry != 0; i++) {
+		const uint32_t t = (uint32_t)a[i] + carry;
+		r[i] = (int32_t)(t & 0x7fffffff);
+		carry = t >> 31;
+	}
+
+	if (r != a)
+		std::copy(a + i, a + na, r + i);
+
+	return carry;
+}
+
+/**
+	*	@brief Subtracts the positive words sequences a and b (na >= nb) and
+	*	writes the na words of the difference into r. r may be a.
+	*	@return Borrow out of the word na-1.
+*/
+static int32_t sub_words(int32_t * r, const int32_t * a, size_t na,
+													const int32_t * b, size_t nb) {
+
+	uint32_t borrow = 0;
+	size_t i;
+
+	//Wrapped differences keep the low 31 bits and the borrow on the bit 31
+	for (i = 0; i < nb; i++) {
+		const uint32_t t = (uint32_t)a[i] - (uint32_t)b[i] - borrow;
+		r[i] = (int32_t)(t & 0x7fffffff);
+		borrow = t >> 31;
+	}
+
+	for (; i < na && borrow != 0; i++) {
+		const uint32_t t = (uint32_t)a[i] - borrow;
+		r[i] = (int32_t)(t & 0x7fffffff);
+		borrow = t >> 31;
+	}
+
+	if (r != a)
+		std::copy(a + i, a + na, r + i);
+
+	return borrow;
+}
+
+/**
+	*	@brief Compares the positive words sequences a and b, which may have
+	*	leading zero words.
+	*	@return -1, 0 or 1 whether a is lower, equal or greater than b.
+*/
+static int compare_words(const int32_t * a, size_t na, const int32_t * b, size_t nb) {
+
+	for (; na > nb; na--)
+		if (a[na - 1] != 0)
+			return 1;
+
+	for (; nb > na; nb--)
+		if (b[nb - 1] != 0)
+			return -1;
+
+	for (size_t i = na; i > 0; i--)
+		if (a[i - 1] != b[i - 1])
+			return a[i - 1] < b[i - 1]? -1 : 1;
+
+	return 0;
+}
+
+/**
+	*	@brief Writes the na words of |a - b| into r (na >= nb).
+	*	@return true when a is lower than b.
+*/
+static bool abs_diff_words(int32_t * r, const int32_t * a, size_t na,
+														const int32_t * b, size_t nb) {
+
+	if (compare_words(a, na, b, nb) >= 0) {
+		sub_words(r, a, na, b, nb);
+		return false;
+	}
+
+	//a < b implies the words of a over nb are zero
+	sub_words(r, b, nb, a, nb);
+	std::fill(r + nb, r + na, 0);
+
+	return true;
+}
+
+/**
+	*	@brief Gets the word i of the two's complement representation of the
+	*	value having the absolute value words (n words) and the sign passed.
+	*	Words must be read in order, carry keeps the carry of the negation
+	*	between calls and it must be 1 before reading the first word.
+*/
+static inline int32_t twos_complement_word(const int32_t * words, size_t n, size_t i,
+																						bool negative, uint32_t & carry) {
+
+	uint32_t word = i < n? (uint32_t)words[i] : 0;
+
+	//-x = ~x + 1
+	if (negative) {
+		word = (~word & 0x7fffffff) + carry;
+		carry = word >> 31;
+		word &= 0x7fffffff;
+	}
+
+	return (int32_t)word;
+}
+
+/////	Batch multiplication helpers /////
+
+/**
+	*	Batch kernels multiply several independent pairs of n words at once, one
+	*	pair per 64 bits lane. Words are interleaved: word k of the pair on lane l
+	*	is stored at a[k*lanes + l], and the 2n words of every product are written
+	*	in the same way into r. Every 64 bits step adds a word (< 2^31), a 31x31
+	*	bits product (< 2^62) and a carry (< 2^33), so it never overflows.
+*/
+typedef void (*batch_kernel)(uint64_t * r, const uint64_t * a, const uint64_t * b, size_t n);
+
+#define BATCH_GENERIC_LANES 4	// <- Number of lanes of the portable batch kernel
+
+/**
+	*	@brief Portable batch kernel on BATCH_GENERIC_LANES lanes.
+*/
+static void mul_batch_generic(uint64_t * r, const uint64_t * a, const uint64_t * b, size_t n) {
+
+	const size_t lanes = BATCH_GENERIC_LANES;
+
+	std::fill(r, r + 2 * n * lanes, 0);
+
+	for (size_t i = 0; i < n; i++) {
+		uint64_t carry[lanes] = {0};
+
+		for (size_t j = 0; j < n; j++)
+			for (size_t l = 0; l < lanes; l++) {
+				const uint64_t t = r[(i + j) * lanes + l] + a[i * lanes + l] * b[j * lanes + l] + carry[l];
+				r[(i + j) * lanes + l] = t & 0x7fffffff;
+				carry[l] = t >> 31;
+			}
+
+		for (size_t l = 0; l < lanes; l++)
+			r[(i + n) * lanes + l] = carry[l];
+	}
+}
+
+#ifdef INTEGER_X86_SIMD
+
+/**
+	*	@brief AVX2 batch kernel on 4 lanes.
+*/
+__attribute__((target("avx2")))
+static void mul_batch_avx2(uint64_t * r, const uint64_t * a, const uint64_t * b, size_t n) {
+
+	const __m256i mask = _mm256_set1_epi64x(0x7fffffff);
+
+	std::fill(r, r + 2 * n * 4, 0);
+
+	for (size_t i = 0; i < n; i++) {
+		const __m256i ai = _mm256_loadu_si256((const __m256i *)(a + i * 4));
+		__m256i carry = _mm256_setzero_si256();
+
+		for (size_t j = 0; j < n; j++) {
+			__m256i * rij = (__m256i *)(r + (i + j) * 4);
+			const __m256i bj = _mm256_loadu_si256((const __m256i *)(b + j * 4));
+
+			__m256i t = _mm256_add_epi64(_mm256_loadu_si256(rij), _mm256_mul_epu32(ai, bj));
+			t = _mm256_add_epi64(t, carry);
+
+			_mm256_storeu_si256(rij, _mm256_and_si256(t, mask));
+			carry = _mm256_srli_epi64(t, 31);
+		}
+
+		_mm256_storeu_si256((__m256i *)(r + (i + n) * 4), carry);
+	}
+}
+
+/**
+	*	@brief AVX-512 batch kernel on 8 lanes. Zero-masking forms with every lane
+	*	selected are used, since the unmasked ones pass an undefined source that
+	*	GCC reports as uninitialized.
+*/
+__attribute__((target("avx512f")))
+static void mul_batch_avx512(uint64_t * r, const uint64_t * a, const uint64_t * b, size_t n) {
+
+	const __m512i mask = _mm512_set1_epi64(0x7fffffff);
+	const __mmask8 all = 0xff;
+
+	std::fill(r, r + 2 * n * 8, 0);
+
+	for (size_t i = 0; i < n; i++) {
+		const __m512i ai = _mm512_loadu_si512(a + i * 8);
+		__m512i carry = _mm512_setzero_si512();
+
+		for (size_t j = 0; j < n; j++) {
+			uint64_t * rij = r + (i + j) * 8;
+			const __m512i bj = _mm512_loadu_si512(b + j * 8);
+
+			__m512i t = _mm512_add_epi64(_mm512_loadu_si512(rij), _mm512_maskz_mul_epu32(all, ai, bj));
+			t = _mm512_add_epi64(t, carry);
+
+			_mm512_storeu_si512(rij, _mm512_and_si512(t, mask));
+			carry = _mm512_maskz_srli_epi64(all, t, 31);
+		}
+
+		_mm512_storeu_si512(r + (i + n) * 8, carry);
+	}
+}
+
+#endif
+
+/**
+	*	@brief Selects the widest batch kernel supported by the host CPU.
+	*	@param lanes Receives the number of lanes of the selected kernel.
+*/
+static batch_kernel select_batch_kernel(size_t & lanes) {
+
+	#ifdef INTEGER_X86_SIMD
+		__builtin_cpu_init();
+
+		if (__builtin_cpu_supports("avx512f")) {
+			lanes = 8;
+			return mul_batch_avx512;
+		}
+
+		if (__builtin_cpu_supports("avx2")) {
+			lanes = 4;
+			return mul_batch_avx2;
+		}
+	#endif
+
+	lanes = BATCH_GENERIC_LANES;
+	return mul_batch_generic;
+}
+
+/////	Product tree helpers /////
+
+/**
+	*	@brief Computes the next level of a product tree: parent j is the product
+	*	of children 2j and 2j+1, or a copy of child 2j when it has no sibling.
+	*	Products are split across threads on large levels.
+*/
+static void product_level(std::span<const Integer> children, std::vector<Integer> & parents,
+														size_t n_threads) {
+
+	const size_t n_parents = (children.size() + 1) / 2;
+	size_t n_words = 0;
+
+	for (const Integer & child : children)
+		n_words += child.n_bits() / N_BITS_PER_WORD + 1;
+
+	parents.resize(n_parents);
+
+	if (n_words < PRODUCT_TREE_PARALLEL_WORDS)
+		n_threads = 1;
+
+	parallel_for(0, n_parents, MIN(n_threads, n_parents), [&](size_t lo, size_t hi) {
+		for (size_t j = lo; j < hi; j++)
+			if (2 * j + 1 < children.size())
+				parents[j] = children[2 * j] * children[2 * j + 1];
+			else
+				parents[j] = children[2 * j];
+	});
+}
+
+/////	Karatsuba multiplication helpers /////
+
+/**
+	*	@brief Number of words of workspace required by mul_karatsuba for n words
+	*	operands, with the given Karatsuba threshold (the current one by default).
+	*	Workspaces sized for threshold 2, the lowest one accepted, fit every
+	*	threshold.
+*/
+static size_t karatsuba_workspace(size_t n,
+								size_t threshold = Integer::get_thresholds().karatsuba_multiply) {
+
+	size_t size = 0;
+
+	while (n >= threshold) {
+		const size_t h = n - n / 2;
+		size += 4 * h + 1;
+		n = h;
+	}
+
+	return size;
+}
+
+/**
+	*	@brief Karatsuba product of the n words sequences a and b. Writes the 2n
+	*	words of the product into r, which must not overlap a or b.
+	*
+	*	Operands are split into a0 (m = n/2 words) and a1 (h = n-m words). The
+	*	low and high products are written straight into their place on r and
+	*	the middle term a0*b1 + a1*b0 = a0*b0 + a1*b1 - (a1-a0)*(b1-b0) is added
+	*	at word m. Differences are kept as magnitude and sign so every partial
+	*	product has h words as max.
+	*
+	*	@param ws Workspace of karatsuba_workspace(n) words.
+*/
+static void mul_karatsuba(int32_t * r, const int32_t * a, const int32_t * b, size_t n,
+														int32_t * ws) {
+
+	const Integer::Thresholds & thresholds = Integer::get_thresholds();
+
+	if (n < thresholds.karatsuba_multiply) {
+		mul_basecase(r, a, n, b, n);
+		return;
+	}
+
+	if (n >= thresholds.ntt_multiply && 2 * n <= ((size_t)1 << NTT_MAX_LOG)) {
+		ntt_multiply(r, a, n, b, n, Integer::get_n_threads());
+		return;
+	}
+
+	const size_t m = n / 2, h = n - m;
+
+	//Workspace layout: t (2h) | da (h) | db (h), mid (2h+1) reuses da and db
+	int32_t * t = ws, * da = ws + 2 * h, * db = ws + 3 * h, * mid = ws + 2 * h;
+	int32_t * next = ws + 4 * h + 1;
+
+	const bool negative_a = abs_diff_words(da, a + m, h, a, m);
+	const bool negative_b = abs_diff_words(db, b + m, h, b, m);
+
+	mul_karatsuba(t, da, db, h, next);
+	mul_karatsuba(r, a, b, m, next);
+	mul_karatsuba(r + 2 * m, a + m, b + m, h, next);
+
+	//mid = a0*b0 + a1*b1 -/+ |a1-a0|*|b1-b0|
+	mid[2 * h] = add_words(mid, r + 2 * m, 2 * h, r, 2 * m);
+
+	int32_t overflow;
+
+	if (negative_a == negative_b)
+		overflow = sub_words(mid, mid, 2 * h + 1, t, 2 * h);
+	else
+		overflow = add_words(mid, mid, 2 * h + 1, t, 2 * h);
+
+	overflow |= add_words(r + m, r + m, m + 2 * h, mid, 2 * h + 1);
+
+	//Middle term is positive and the product fits on 2n words
+	#ifdef DEBUG
+		assert(overflow == 0);
+	#endif
+}
+
+/**
+	*	@brief Product of the positive words sequences a and b through Karatsuba
+	*	algorithm. Writes the na+nb words of the product into r, which must not
+	*	overlap a or b. Unbalanced operands are multiplied by slices of the
+	*	shorter operand size.
+*/
+static void mul_karatsuba_unbalanced(int32_t * r, const int32_t * a, size_t na,
+																			const int32_t * b, size_t nb) {
+
+	if (na < nb) {
+		std::swap(a, b);
+		std::swap(na, nb);
+	}
+
+	if (nb < Integer::get_thresholds().karatsuba_multiply) {
+		mul_basecase(r, a, na, b, nb);
+		return;
+	}
+
+	std::vector<int32_t> ws(karatsuba_workspace(nb));
+
+	if (na == nb) {
+		mul_karatsuba(r, a, b, nb, ws.data());
+		return;
+	}
+
+	std::vector<int32_t> slice(2 * nb);
+
+	std::fill(r, r + na + nb, 0);
+
+	for (size_t i = 0; i < na; i += nb) {
+		const size_t length = MIN(nb, na - i);
+
+		if (length == nb)
+			mul_karatsuba(slice.data(), a + i, b, nb, ws.data());
+		else
+			mul_karatsuba_unbalanced(slice.data(), b, nb, a + i, length);
+
+		add_words(r + i, r + i, na + nb - i, slice.data(), nb + length);
+	}
+}
+
+/////	Short products helpers /////
+
+/**
+	*	@brief Schoolbook low short product. Writes the n less significant words
+	*	of a*b into r, where a and b have n words.
+*/
+static void mul_low_basecase(int32_t * r, const int32_t * a, const int32_t * b, size_t n) {
+
+	std::fill(r, r + n, 0);
+
+	for (size_t i = 0; i < n; i++) {
+		uint64_t carry = 0;
+
+		//Partial products falling over the word n are skipped
+		for (size_t j = 0; j < n - i; j++) {
+			carry += (uint64_t)r[i + j] + (uint64_t)a[i] * (uint64_t)b[j];
+			r[i + j] = (int32_t)(carry & 0x7fffffff);
+			carry >>= 31;
+		}
+	}
+}
+
+/**
+	*	@brief Schoolbook high short product. Writes floor(P / 2^(31*n)) into r
+	*	(n words), where P is the sum of the partial products of a and b (n
+	*	words) falling into the words n-1 or above.
+*/
+static void mul_high_basecase(int32_t * r, const int32_t * a, const int32_t * b, size_t n) {
+
+	// Words n-1 .. 2n-1 of the partial sum
+	std::vector<int32_t> aux(n + 1, 0);
+
+	for (size_t i = 0; i < n; i++) {
+		uint64_t carry = 0;
+
+		//Partial products falling under the word n-1 are skipped
+		for (size_t j = n - 1 - i; j < n; j++) {
+			carry += (uint64_t)aux[i + j - (n - 1)] + (uint64_t)a[i] * (uint64_t)b[j];
+			aux[i + j - (n - 1)] = (int32_t)(carry & 0x7fffffff);
+			carry >>= 31;
+		}
+
+		aux[i + 1] = (int32_t)carry;
+	}
+
+	std::copy(aux.begin() + 1, aux.end(), r);
+}
+
+/**
+	*	@brief Schoolbook middle product. Writes into r (n+2 words) the sum of the
+	*	partial products a_i * b_j * 2^(31*(i+j-n+1)) with n-1 <= i+j <= 2n-2,
+	*	where a has 2n-1 words and b has n words.
+*/
+static void mul_mid_basecase(int32_t * r, const int32_t * a, const int32_t * b, size_t n) {
+
+	std::fill(r, r + n + 2, 0);
+
+	for (size_t j = 0; j < n; j++) {
+		uint64_t carry = 0;
+
+		for (size_t k = 0; k < n; k++) {
+			carry += (uint64_t)r[k] + (uint64_t)a[k + n - 1 - j] * (uint64_t)b[j];
+			r[k] = (int32_t)(carry & 0x7fffffff);
+			carry >>= 31;
+		}
+
+		for (size_t k = n; carry != 0; k++) {
+			carry += r[k];
+			r[k] = (int32_t)(carry & 0x7fffffff);
+			carry >>= 31;
+		}
+	}
+}
+
+/**
+	*	@brief Transposed Karatsuba middle product on coefficient sequences.
+	*	Writes c_k = sum(x_(k+n-1-j) * y_j) for 0 <= k < n, where x has 2n-1
+	*	coefficients and y has n coefficients. Coefficients are kept without
+	*	carries (and can be negative on the recursive calls) so the identities
+	*	of the transposed algorithm hold coefficient by coefficient.
+*/
+static void mul_mid_coefficients(__int128 * c, const __int128 * x, const __int128 * y, size_t n) {
+
+	if (n <= 2 || n <= Integer::get_thresholds().short_product) {
+		for (size_t k = 0; k < n; k++) {
+			c[k] = 0;
+			for (size_t j = 0; j < n; j++)
+				c[k] += x[k + n - 1 - j] * y[j];
+		}
+	}
+	else if (n % 2 == 1) {
+		//Odd length is extended with a leading zero coefficient on y
+		std::vector<__int128> xe(2 * n + 1, 0), ye(n + 1, 0), ce(n + 1);
+
+		std::copy(x, x + 2 * n - 1, xe.begin() + 1);
+		std::copy(y, y + n, ye.begin());
+
+		mul_mid_coefficients(ce.data(), xe.data(), ye.data(), n + 1);
+		std::copy(ce.begin(), ce.begin() + n, c);
+	}
+	else {
+		const size_t m = n / 2;
+		std::vector<__int128> x01(2 * m - 1), x12(2 * m - 1), y01(m);
+		std::vector<__int128> alpha(m), beta(m), gamma(m);
+
+		for (size_t t = 0; t < 2 * m - 1; t++) {
+			x01[t] = x[t] + x[m + t];
+			x12[t] = x[m + t] + x[2 * m + t];
+		}
+
+		for (size_t t = 0; t < m; t++)
+			y01[t] = y[t] - y[m + t];
+
+		/* MP(x, y) = (alpha + beta) || (gamma - beta) where
+		 *	alpha = MP(x0 + x1, y1), beta = MP(x1, y0 - y1), gamma = MP(x1 + x2, y0) */
+		mul_mid_coefficients(alpha.data(), x01.data(), y + m, m);
+		mul_mid_coefficients(beta.data(), x + m, y01.data(), m);
+		mul_mid_coefficients(gamma.data(), x12.data(), y, m);
+
+		for (size_t k = 0; k < m; k++) {
+			c[k] = alpha[k] + beta[k];
+			c[m + k] = gamma[k] - beta[k];
+		}
+	}
+}
+
+/////	Division helpers /////
+
+/**
+	*	Division kernels work on words buffers whose most significant words may
+	*	be zero. The number of significant words is tracked by the callers and
+	*	the result is normalized once when it is stored into an Integer.
+*/
+
+/**
+	*	@brief Divides in place the n words of a by the single word d.
+	*	@return Remainder of the division.
+*/
+static uint32_t div_word(int32_t * a, size_t n, uint32_t d) {
+
+	uint64_t remainder = 0;
+
+	for (size_t i = n; i > 0; i--) {
+		const uint64_t current = (remainder << 31) | (uint32_t)a[i - 1];
+		a[i - 1] = (int32_t)(current / d);
+		remainder = current % d;
+	}
+
+	return (uint32_t)remainder;
+}
+
+/**
+	*	@brief Multiplies in place the n words of a by the single word m and adds
+	*	the word c.
+	*	@return Carry out of the word n-1.
+*/
+static uint32_t mul_add_word(int32_t * a, size_t n, uint32_t m, uint32_t c) {
+
+	uint64_t carry = c;
+
+	for (size_t i = 0; i < n; i++) {
+		carry += (uint64_t)(uint32_t)a[i] * m;
+		a[i] = (int32_t)(carry & 0x7fffffff);
+		carry >>= 31;
+	}
+
+	return (uint32_t)carry;
+}
+
+/**
+	*	@brief Long division (Knuth's algorithm D) of the words sequences a and b
+	*	(na >= nb, b[nb-1] != 0). Writes the na-nb+1 words of the quotient into q
+	*	and the nb words of the remainder into r.
+*/
+static void divide_words(int32_t * q, int32_t * r, const int32_t * a, size_t na,
+													const int32_t * b, size_t nb) {
+
+	if (nb == 1) {
+		std::copy(a, a + na, q);
+		r[0] = (int32_t)div_word(q, na, (uint32_t)b[0]);
+		return;
+	}
+
+	//Divisor is shifted until its most significant bit is the bit 30 of its top word
+	size_t shift = 0;
+
+	while (((uint32_t)b[nb - 1] << shift & 0x40000000) == 0)
+		shift++;
+
+	std::vector<int32_t> u(na + 1), v(nb);
+
+	for (size_t i = nb; i > 0; i--)
+		v[i - 1] = (int32_t)((((uint32_t)b[i - 1] << shift) |
+												(i > 1? (uint32_t)b[i - 2] >> (31 - shift) : 0)) & 0x7fffffff);
+
+	u[na] = shift > 0? (int32_t)((uint32_t)a[na - 1] >> (31 - shift)) : 0;
+
+	for (size_t i = na; i > 0; i--)
+		u[i - 1] = (int32_t)((((uint32_t)a[i - 1] << shift) |
+												(i > 1? (uint32_t)a[i - 2] >> (31 - shift) : 0)) & 0x7fffffff);
+
+	const uint64_t base = (uint64_t)1 << 31;
+	const uint64_t top = (uint32_t)v[nb - 1], second = (uint32_t)v[nb - 2];
+
+	for (size_t j = na - nb + 1; j > 0; j--) {
+		int32_t * uj = u.data() + j - 1;
+
+		//Estimate the quotient word from the two most significant words
+		const uint64_t numerator = ((uint64_t)uj[nb] << 31) | (uint32_t)uj[nb - 1];
+		uint64_t qhat = numerator / top, rhat = numerator % top;
+
+		while (qhat >= base || qhat * second > ((rhat << 31) | (uint32_t)uj[nb - 2])) {
+			qhat--;
+			rhat += top;
+
+			if (rhat >= base)
+				break;
+		}
+
+		//Subtract qhat*v from the current window
+		int64_t borrow = 0;
+
+		for (size_t i = 0; i < nb; i++) {
+			const uint64_t p = qhat * (uint32_t)v[i];
+			const int64_t t = (int64_t)(uint32_t)uj[i] - borrow - (int64_t)(p & 0x7fffffff);
+
+			uj[i] = (int32_t)(t & 0x7fffffff);
+			borrow = (int64_t)(p >> 31) - (t >> 31);
+		}
+
+		const int64_t t = (int64_t)(uint32_t)uj[nb] - borrow;
+		uj[nb] = (int32_t)(t & 0x7fffffff);
+
+		//The estimate was one unit too large, v is added back
+		if (t < 0) {
+			qhat--;
+			uj[nb] = (int32_t)((uint32_t)uj[nb] + add_words(uj, uj, nb, v.data(), nb)) & 0x7fffffff;
+		}
+
+		q[j - 1] = (int32_t)qhat;
+	}
+
+	//Remainder is shifted back
+	for (size_t i = 0; i < nb; i++)
+		r[i] = (int32_t)((((uint32_t)u[i] >> shift) |
+											((uint32_t)u[i + 1] << (31 - shift))) & 0x7fffffff);
+}
+
+/////	GCD helpers /////
+
+/**
+	*	@brief Binary GCD of two native words. Trailing zeros are removed at once
+	*	through their count.
+*/
+static uint64_t gcd_native(uint64_t a, uint64_t b) {
+
+	if (a == 0)
+		return b;
+
+	if (b == 0)
+		return a;
+
+	const int shift = std::countr_zero(a | b);
+	a >>= std::countr_zero(a);
+
+	do {
+		b >>= std::countr_zero(b);
+
+		if (a > b)
+			std::swap(a, b);
+
+		b -= a;
+	} while (b != 0);
+
+	return a << shift;
+}
+
+/**
+	*	@brief Removes the zero most significant words of w, keeping one word as
+	*	min.
+*/
+static void trim_words(std::vector<int32_t> & w) {
+
+	while (w.size() > 1 && w.back() == 0)
+		w.pop_back();
+}
+
+/**
+	*	@brief Gets the n words w shifted right by shift bits, for values lower
+	*	than 2^(shift+64).
+*/
+static uint64_t shifted_bits(const int32_t * w, size_t n, size_t shift) {
+
+	const size_t i = shift / N_BITS_PER_WORD, offset = shift % N_BITS_PER_WORD;
+	unsigned __int128 bits = 0;
+
+	for (size_t j = MIN(n, i + 4); j > i; j--)
+		bits = (bits << 31) | (uint32_t)w[j - 1];
+
+	return (uint64_t)(bits >> offset);
+}
+
+/**
+	*	@brief Number of significant bits of the n words w, whose most
+	*	significant word is not 0.
+*/
+static size_t bits_words(const int32_t * w, size_t n) {
+	return (n - 1) * N_BITS_PER_WORD + std::bit_width((uint32_t)w[n - 1]);
+}
+
+/**
+	*	@brief Computes the matrix [A B; C D] of the Euclidean steps on u and v
+	*	(u >= v, u over 62 bits) determined by the 62 most significant bits of u
+	*	and the bits of v at the same position (Lehmer's algorithm, Knuth's
+	*	variant with the quotients computed on both bounds of the cosequence).
+	*	@return false when no step can be determined, so a full division step is
+	*	required.
+*/
+static bool lehmer_matrix(const int32_t * u, size_t nu, const int32_t * v, size_t nv,
+													int64_t & A, int64_t & B, int64_t & C, int64_t & D) {
+
+	const size_t shift = bits_words(u, nu) - 62;
+	int64_t x = (int64_t)shifted_bits(u, nu, shift), y = (int64_t)shifted_bits(v, nv, shift);
+
+	A = 1, B = 0, C = 0, D = 1;
+
+	while (y + C > 0 && y + D > 0) {
+		const int64_t q = (x + A) / (y + C);
+
+		//The quotient is only valid when both bounds agree
+		if (q != (x + B) / (y + D))
+			break;
+
+		int64_t t = A - q * C;
+		A = C;
+		C = t;
+
+		t = B - q * D;
+		B = D;
+		D = t;
+
+		t = x - q * y;
+		x = y;
+		y = t;
+	}
+
+	return B != 0;
+}
+
+/**
+	*	@brief Replaces the n words u and v by A*u + B*v and C*u + D*v, which must
+	*	be positive.
+*/
+static void lehmer_apply(int32_t * u, int32_t * v, size_t n,
+													int64_t A, int64_t B, int64_t C, int64_t D) {
+
+	__int128 carry_u = 0, carry_v = 0;
+
+	for (size_t i = 0; i < n; i++) {
+		carry_u += (__int128)A * u[i] + (__int128)B * v[i];
+		carry_v += (__int128)C * u[i] + (__int128)D * v[i];
+
+		u[i] = (int32_t)(carry_u & 0x7fffffff);
+		v[i] = (int32_t)(carry_v & 0x7fffffff);
+
+		carry_u >>= 31;
+		carry_v >>= 31;
+	}
+
+	//Check postcondition
+	#ifdef DEBUG
+		assert(carry_u == 0 && carry_v == 0);
+	#endif
+}
+
+/**
+	*	@brief Euclidean division step on the trimmed words u and v (u >= v > 0):
+	*	(u, v) = (v, u mod v).
+	*
+	*	@param q Buffer for the quotient, whose words are returned on it.
+*/
+static void euclid_step(std::vector<int32_t> & u, std::vector<int32_t> & v,
+												std::vector<int32_t> & q) {
+
+	std::vector<int32_t> r(v.size());
+
+	q.resize(u.size() - v.size() + 1);
+	divide_words(q.data(), r.data(), u.data(), u.size(), v.data(), v.size());
+
+	trim_words(q);
+	trim_words(r);
+
+	u.swap(v);
+	v.swap(r);
+}
+
+/**
+	*	@brief Greatest common divisor of the words u and v through Lehmer's
+	*	algorithm, finished by binary GCD once the values fit in a native word.
+	*	The result is written into u.
+*/
+static void gcd_words(std::vector<int32_t> & u, std::vector<int32_t> & v) {
+
+	trim_words(u);
+	trim_words(v);
+
+	if (compare_words(u.data(), u.size(), v.data(), v.size()) < 0)
+		u.swap(v);
+
+	std::vector<int32_t> q;
+
+	while (v.size() > 1 || v[0] != 0) {
+
+		if (u.size() <= 2) {
+			const uint64_t g = gcd_native(shifted_bits(u.data(), u.size(), 0),
+																		shifted_bits(v.data(), v.size(), 0));
+
+			u.assign({(int32_t)(g & 0x7fffffff), (int32_t)(g >> 31)});
+			trim_words(u);
+			break;
+		}
+
+		int64_t A, B, C, D;
+
+		if (lehmer_matrix(u.data(), u.size(), v.data(), v.size(), A, B, C, D)) {
+			v.resize(u.size(), 0);
+			lehmer_apply(u.data(), v.data(), u.size(), A, B, C, D);
+			trim_words(u);
+			trim_words(v);
+		}
+		else
+			euclid_step(u, v, q);
+	}
+}
+
+/////	Root helpers /////
+
+/**
+	*	@brief Square root of a native word, seeded by the floating point root and
+	*	corrected to its floor.
+*/
+static uint64_t sqrt_native(uint64_t n) {
+
+	uint64_t s = (uint64_t)std::sqrt((double)n);
+
+	//The rounded estimate may miss the floor by a unit either way
+	while ((unsigned __int128)s * s > n)
+		s--;
+
+	while ((unsigned __int128)(s + 1) * (s + 1) <= n)
+		s++;
+
+	return s;
+}
+
+/**
+	*	@brief Remainder of the division of the n words w by d.
+*/
+static uint32_t mod_word(const int32_t * w, size_t n, uint32_t d) {
+
+	uint64_t remainder = 0;
+
+	for (size_t i = n; i > 0; i--)
+		remainder = ((remainder << 31) | (uint32_t)w[i - 1]) % d;
+
+	return (uint32_t)remainder;
+}
+
+/**
+	*	@brief Determines whether r is a square modulo M, through a table of the
+	*	squares modulo M built on first use.
+*/
+template <uint32_t M>
+static bool is_square_residue(uint32_t r) {
+
+	static const std::array<bool, M> squares = []() {
+		std::array<bool, M> table{};
+
+		for (uint32_t i = 0; i < M; i++)
+			table[i * i % M] = true;
+
+		return table;
+	}();
+
+	return squares[r];
+}
+
+/**
+	*	@brief k-th root (k >= 2) of a native word, seeded by the floating point
+	*	root and corrected to its floor.
+*/
+static uint64_t root_native(uint64_t n, size_t k) {
+
+	//Whether x^k exceeds n, stopping as soon as the partial power does
+	auto exceeds = [&](uint64_t x) {
+		unsigned __int128 power = 1;
+
+		for (size_t i = 0; i < k; i++)
+			if ((power *= x) > n)
+				return true;
+
+		return false;
+	};
+
+	uint64_t r = (uint64_t)std::pow((double)n, 1.0 / (double)k);
+
+	while (r > 0 && exceeds(r))
+		r--;
+
+	while (!exceeds(r + 1))
+		r++;
+
+	return r;
+}
+
+/**
+	*	@brief p-th root (p odd) of the odd native word x modulo 2^64, which is
+	*	unique as x -> x^p is a bijection on the odd residues. It is x^e, being e
+	*	the inverse of p modulo 2^62, the exponent of the odd residues group.
+*/
+static uint64_t root_2adic(uint64_t x, uint64_t p) {
+
+	//Inverse of p modulo 2^64 through Newton's iteration, each step doubles
+	//the correct bits from the 3 bits of p*p = 1 (mod 8)
+	uint64_t e = p, r = 1;
+
+	for (size_t i = 0; i < 5; i++)
+		e *= 2 - p * e;
+
+	while (e > 0) {
+		if (e & 1)
+			r *= x;
+
+		x *= x;
+		e >>= 1;
+	}
+
+	return r;
+}
+
+/**
+	*	@brief Determines whether the native word n is prime, by trial division.
+*/
+static bool is_prime_native(uint64_t n) {
+
+	if (n < 4)
+		return n >= 2;
+
+	if (n % 2 == 0)
+		return false;
+
+	for (uint64_t d = 3; d * d <= n; d += 2)
+		if (n % d == 0)
+			return false;
+
+	return true;
+}
+
+/**
+	*	@brief Determines whether the n words w may be a p-th power (p prime) by
+	*	their residues modulo the first two primes q = 1 (mod p), where p-th
+	*	powers are the residues r with r^((q-1)/p) = 1, or 0.
+*/
+static bool is_power_residue(const int32_t * w, size_t n, size_t p) {
+
+	size_t n_filters = 0;
+
+	for (uint64_t q = 2 * p + 1; n_filters < 2 && q < ((uint64_t)1 << 31); q += 2 * p) {
+
+		if (!is_prime_native(q))
+			continue;
+
+		const uint32_t r = mod_word(w, n, (uint32_t)q);
+
+		if (r != 0 && pow_mod(r, (q - 1) / p, (uint32_t)q) != 1)
+			return false;
+
+		n_filters++;
+	}
+
+	return true;
+}
+
+/////	Exponentiation helpers /////
+
+/**
+	*	@brief Number of bits of the windows used to exponentiate to an exponent
+	*	of n_bits bits. Windows grow with the exponent length, so the table of
+	*	odd powers stays amortized.
+*/
+static size_t window_bits(size_t n_bits) {
+
+	if (n_bits > 671)
+		return 6;
+	else if (n_bits > 239)
+		return 5;
+	else if (n_bits > 79)
+		return 4;
+	else if (n_bits > 23)
+		return 3;
+	else if (n_bits > 7)
+		return 2;
+
+	return 1;
+}
+
+/**
+	*	@brief Walks the exponent held by the ne positive words e (less significant
+	*	first) from its most significant bit through windows of k bits as max
+	*	ended on a 1 bit. first(i) is called for the first window and square()
+	*	for every bit after it, plus multiply(i) at the end of every window but
+	*	the first one, where 2i+1 is the value of the window.
+*/
+template <class FIRST, class SQUARE, class MULTIPLY>
+static void sliding_window(const int32_t * e, size_t ne, size_t k, const FIRST & first,
+														const SQUARE & square, const MULTIPLY & multiply) {
+
+	auto bit = [e](size_t i) -> size_t {
+		return ((uint32_t)e[i / N_BITS_PER_WORD] >> (i % N_BITS_PER_WORD)) & 1;
+	};
+
+	size_t i = ne * N_BITS_PER_WORD;
+	bool started = false;
+
+	while (i > 0 && bit(i - 1) == 0)
+		i--;
+
+	while (i > 0) {
+		if (bit(i - 1) == 0) {
+			square();
+			i--;
+			continue;
+		}
+
+		//Longest window [l, i) up to k bits ended on a 1 bit
+		size_t l = i > k? i - k : 0;
+
+		while (bit(l) == 0)
+			l++;
+
+		size_t window = 0;
+
+		for (size_t j = i; j-- > l;)
+			window = (window << 1) | bit(j);
+
+		if (!started) {
+			first(window >> 1);
+			started = true;
+		}
+		else {
+			for (size_t j = l; j < i; j++)
+				square();
+
+			multiply(window >> 1);
+		}
+
+		i = l;
+	}
+}
+
+/////	Montgomery multiplication helpers /////
+
+/**
+	*	@brief Gets a workspace of n words as min owned by the calling thread,
+	*	reused by the ModInteger operations.
+*/
+static int32_t * thread_workspace(size_t n) {
+
+	thread_local std::vector<int32_t> ws;
+
+	if (ws.size() < n)
+		ws.resize(n);
+
+	return ws.data();
+}
+
+/**
+	*	@brief Computes -m^-1 mod 2^31 for the odd word m. Every Newton iteration
+	*	doubles the number of correct bits of the inverse, starting by 3 bits.
+*/
+static uint32_t montgomery_inverse(uint32_t m) {
+
+	uint32_t x = m;
+
+	for (size_t i = 0; i < 4; i++)
+		x *= 2 - m * x;
+
+	return (0u - x) & 0x7fffffff;
+}
+
+/**
+	*	@brief Number of words of workspace required by montgomery_mul for n words
+	*	moduli. It is sized for the Karatsuba path under the lowest threshold, so
+	*	thresholds changed between sizing and use cannot overflow it.
+*/
+static size_t montgomery_workspace(size_t n) {
+
+	return 2 * n + 1 + karatsuba_workspace(n, 2);
+}
+
+/**
+	*	@brief Subtracts m from the n+1 words t (t < 2m) when t >= m and writes
+	*	the n words of the result into r.
+*/
+static void montgomery_correct(int32_t * r, int32_t * t, const int32_t * m, size_t n) {
+
+	if (t[n] != 0 || compare_words(t, n, m, n) >= 0)
+		sub_words(t, t, n + 1, m, n);
+
+	std::copy(t, t + n, r);
+}
+
+/**
+	*	@brief Montgomery reduction (REDC) of the 2n+1 words t (t < m*2^(31n)),
+	*	whose most significant word must be 0. Writes t/2^(31n) mod m into the n
+	*	words of r. Words of t are overwritten.
+*/
+static void montgomery_redc(int32_t * r, int32_t * t, const int32_t * m, size_t n,
+														uint32_t m_inv) {
+
+	for (size_t i = 0; i < n; i++) {
+		//u makes the word i of t + u*m*2^(31i) zero
+		const uint64_t u = ((uint32_t)t[i] * m_inv) & 0x7fffffff;
+		uint64_t carry = 0;
+
+		for (size_t j = 0; j < n; j++) {
+			carry += (uint64_t)t[i + j] + u * (uint64_t)m[j];
+			t[i + j] = (int32_t)(carry & 0x7fffffff);
+			carry >>= 31;
+		}
+
+		for (size_t j = i + n; carry != 0; j++) {
+			carry += (uint64_t)t[j];
+			t[j] = (int32_t)(carry & 0x7fffffff);
+			carry >>= 31;
+		}
+	}
+
+	montgomery_correct(r, t + n, m, n);
+}
+
+/**
+	*	@brief Montgomery product of the n words sequences a and b (both lower
+	*	than m). Writes a*b/2^(31n) mod m into the n words of r, which may be a or
+	*	b. Small moduli interleave the product and the reduction word by word
+	*	(CIOS), while big ones reduce the Karatsuba product.
+	*
+	*	@param ws Workspace of montgomery_workspace(n) words.
+*/
+static void montgomery_mul(int32_t * r, const int32_t * a, const int32_t * b,
+														const int32_t * m, size_t n, uint32_t m_inv, int32_t * ws) {
+
+	if (n >= Integer::get_thresholds().karatsuba_multiply) {
+		mul_karatsuba(ws, a, b, n, ws + 2 * n + 1);
+		ws[2 * n] = 0;
+		montgomery_redc(r, ws, m, n, m_inv);
+		return;
+	}
+
+	int32_t * t = ws;
+	std::fill(t, t + n + 2, 0);
+
+	for (size_t i = 0; i < n; i++) {
+		const uint64_t bi = (uint64_t)b[i];
+		uint64_t carry = 0;
+
+		//t += a*b[i]
+		for (size_t j = 0; j < n; j++) {
+			carry += (uint64_t)t[j] + (uint64_t)a[j] * bi;
+			t[j] = (int32_t)(carry & 0x7fffffff);
+			carry >>= 31;
+		}
+
+		carry += (uint64_t)t[n];
+		t[n] = (int32_t)(carry & 0x7fffffff);
+		t[n + 1] = (int32_t)(carry >> 31);
+
+		//t = (t + u*m) / 2^31, being u the one making the division exact
+		const uint64_t u = ((uint32_t)t[0] * m_inv) & 0x7fffffff;
+		carry = ((uint64_t)t[0] + u * (uint64_t)m[0]) >> 31;
+
+		for (size_t j = 1; j < n; j++) {
+			carry += (uint64_t)t[j] + u * (uint64_t)m[j];
+			t[j - 1] = (int32_t)(carry & 0x7fffffff);
+			carry >>= 31;
+		}
+
+		carry += (uint64_t)t[n];
+		t[n - 1] = (int32_t)(carry & 0x7fffffff);
+		t[n] = (int32_t)((uint64_t)t[n + 1] + (carry >> 31));
+	}
+
+	montgomery_correct(r, t, m, n);
+}
+
+void Integer::Words::unshare() {
+
+	//Words are only taken over if no other copy can read them. The fence orders
+	//the reads done by the last copies released before taking the words over
+	if (this->_shared.use_count() == 1) {
+		std::atomic_thread_fence(std::memory_order_acquire);
+		this->_words = std::move(*this->_shared);
+	}
+	else
+		this->_words = *this->_shared;
+
+	this->_shared.reset();
+}
+
+void Integer::fix() {
+
+	/*	Find the first significant word (every word having 0 value at beginning
+	 *	is redundant, a non-significant word, so they must be removed). Words are
+	 *	read through a const reference, so shared words are not cloned */
+	const Words & words = this->_words;
+	size_t n = words.size();
+
+	while (n > 1 && words[n - 1] == 0)
+		n--;
+
+	if (n == 0) {
+		this->_words.push_back(0);
+		n = 1;
+	}
+
+	if (n < words.size())
+		this->_words.truncate(n);
+
+	//Zero is always positive
+	if (n == 1 && words[0] == 0)
+		this->_negative = false;
+
+	//Check postcondition
+	#ifdef DEBUG
+		assert(!(words.size() > 1) || words.back() != 0);
+
+		for (size_t i = 0; i < words.size(); i++)
+			assert((words[i] & 0x80000000) == 0);
+	#endif
+
+	return;
+}
+
+void Integer::complement_words() {
+
+	//|x| = 2^(31n) - w, where w are the n words holding x in two's complement
+	uint32_t carry = 1;
+
+	for (size_t i = 0; i < this->_words.size(); i++) {
+		const uint32_t t = (~(uint32_t)this->_words[i] & 0x7fffffff) + carry;
+		this->_words[i] = (int32_t)(t & 0x7fffffff);
+		carry = t >> 31;
+	}
+
+	//Words were all zero, so |x| = 2^(31n)
+	if (carry != 0) {
+		this->resize(this->_words.size() + 1);
+		this->_words.back() = 1;
+	}
+
+	this->_negative = !this->_negative;
+}
+
+void Integer::add(const Integer & n1, const Integer & n2, bool negative) {
+
+	#ifdef DEBUG
+		Integer n1_org(n1), n2_org(n2);
+	#endif
+
+	//n2 is read while the current Integer is written
+	if (this == &n2) {
+		const Integer n2_aux(n2);
+		this->add(n1, n2_aux, negative);
+		return;
+	}
+
+	if (this != &n1) {
+		this->_words.reserve(MAX(n1._words.size(), n2._words.size()) + 1);
+		this->_words.assign(n1._words.begin(), n1._words.end());
+		this->_negative = n1._negative;
+	}
+
+	//Signs decide whether magnitudes are added or subtracted
+	this->accumulate_words(n2._words.data(), n2._words.size(), n2._negative ^ negative);
+
+	//Check postconditions
+	#ifdef DEBUG
+		// n1 + n2 = this => this >= n1 && this >= n2
+		assert( ((negative ^ n2_org.is_negative()) || n1_org.is_negative()) ||
+			(this->compare(n1_org) >= 0 && this->compare(Integer::abs(n2_org)) >= 0));
+
+		// n1 - n2 = this => this <= n1
+		assert( !(negative ^ n2_org.is_negative() && !n1_org.is_negative()) ||
+																			this->compare(n1_org) <= 0);
+
+		// n2 - n1 = this => this <= n2
+		assert( !(!(negative ^ n2_org.is_negative()) && n1_org.is_negative()) ||
+																			this->compare(Integer::abs(n2_org)) <= 0);
+
+		// - n1 - n2 = this => this <= n1 && this <= n
+		assert( !((negative ^ n2_org.is_negative()) && n1_org.is_negative()) ||
+			(this->compare(n1_org) <= 0 && this->compare(n2_org) <= 0));
+
+		// On n1 + 0 = this => n1 = this, on n1 - 0 = this => n1 = this
+		assert(! (n2_org.compare(0) == 0) || this->compare(n1_org) == 0);
+
+		// On 0 + n2 = this => n2 = this, on 0 - n2 = this => -n2 = this
+		assert(! (n1_org.compare(0) == 0) ||
+								this->compare(n2_org) == 0 && !negative ||
+								this->compare(-n2_org) == 0 && negative);
+
+		// When deduct, n1 < n2 => this < 0
+		assert(!((negative ^ n2_org.is_negative() && !n1_org.is_negative()) &&
+										n1_org.compare(Integer::abs(n2_org)) == -1) ||
+												(this->is_negative() && this->compare(0) == -1));
+
+		// When deduct, n1 == n2 => this == 0
+		assert(!((negative ^ n2_org.is_negative() ^ n1_org.is_negative()) &&
+											Integer::abs(n1_org).compare(Integer::abs(n2_org)) == 0) ||
+												(this->is_zero() && this->compare(0) == 0));
+
+		// When deduct, n1 > n2 => this > 0
+		assert(!((negative ^ n2_org.is_negative()) && !n1_org.is_negative() &&
+												n1_org.compare(Integer::abs(n2_org)) == 1) ||
+										(!(this->is_zero() || this->is_negative())  &&
+											this->compare(0) == 1));
+	#endif
+}
+
+void Integer::multiply(const Integer & n1, const Integer & n2) {
+
+	// Prepare postcondition check
+	#ifdef DEBUG
+		Integer n1_org(n1), n2_org(n2);
+	#endif
+
+	//Products are computed on the absolute values, the sign is set apart
+	const bool sign = n1.is_negative() ^ n2.is_negative();
+
+	//Product by 0
+	if (n1.is_zero() || n2.is_zero())
+		this->reset();
+	else {
+
+		/****************************
+		 *	Algorithm of Karashutba *
+		*****************************/
+
+		//Perform direct multiplication whether integer are small enough
+		if (n1._words.size() == 1 && n2._words.size() == 1) {
+
+			/*The resulting Integer may take 62 bits as max so
+			* it's required to split it into 31 bits-blocks*/
+
+			const uint64_t result = (uint64_t)n1._words[0] * (uint64_t)n2._words[0];
+
+			this->resize(2);
+			this->_words[0] = (int32_t)(result & 0x7fffffff);
+			this->_words[1] = (int32_t)(result >> 31);
+
+			this->fix();
+		}
+		else if (MIN(n1._words.size(), n2._words.size()) < Integer::_thresholds.karatsuba_multiply) {
+			//Integers are small enough to be multiplied word by word
+			this->multiply_schoolbook(n1, n2);
+		}
+		else if (MIN(n1._words.size(), n2._words.size()) >= Integer::_thresholds.ntt_multiply &&
+							n1._words.size() + n2._words.size() <= ((size_t)1 << NTT_MAX_LOG)) {
+			//Integers are big enough to be multiplied through their transforms
+			this->multiply_ntt(n1, n2);
+		}
+		else {
+			//Integers are not small enough so a subdivision is performed
+			this->multiply_karatsuba(n1, n2);
+		}
+
+		this->_negative = sign;
+	}
+
+	// Check postcondition
+	#ifdef DEBUG
+		// On n1 > 1 and n2 > 1, this > n1 and this > n2
+		assert(!(n1_org.compare(1) == 1 && n2_org.compare(1) == 1) ||
+											(this->compare(n1_org) == 1 && this->compare(n2_org) == 1));
+
+		// On n1 == 1 => this == n2
+		assert(!(n1_org.compare(1) == 0) || (this->compare(n2_org) == 0));
+
+		// On n2 == 1 => this == n1
+		assert(!(n2_org.compare(1) == 0) || (this->compare(n1_org) == 0));
+
+		// On n1 = 0 or n2 = 0, this = 0
+		assert(!(n1_org.compare(0) == 0 || n2_org.compare(0) == 0) ||
+											(this->is_zero() && this->compare(0) == 0));
+
+		// On n2 == -1 => this = -n1
+		assert( !(n2_org.compare(-1) == 0) || this->compare(-n1_org) == 0);
+
+		// On n1 == -1 => this = -n2
+		assert( !(n1_org.compare(-1) == 0) || this->compare(-n2_org) == 0);
+
+		// On n1 < 0 ^ n2 < 0 => this <= 0
+		assert( !(n1_org.is_negative() ^ n2_org.is_negative()) || this->is_negative() || this->is_zero());
+
+		// On ¬ (n1_org < 0 ^ n2 < 0) => this >= 0
+		assert( (n1_org.is_negative() ^ n2_org.is_negative()) ||
+					( (!this->is_negative() || this->is_zero()) && this->compare(0) >= 0) );
+
+	#endif
+
+	return;
+}
+
+void Integer::multiply_schoolbook(const Integer & n1, const Integer & n2) {
+
+	std::vector<int32_t> result(n1._words.size() + n2._words.size());
+
+	mul_basecase(result.data(), n1._words.data(), n1._words.size(),
+								n2._words.data(), n2._words.size());
+
+	//Save result into the current Integer
+	this->assign_words(result);
+}
+
+void Integer::multiply_karatsuba(const Integer & n1, const Integer & n2) {
+
+	std::vector<int32_t> result(n1._words.size() + n2._words.size());
+
+	mul_karatsuba_unbalanced(result.data(), n1._words.data(), n1._words.size(),
+														n2._words.data(), n2._words.size());
+
+	//Save result into the current Integer
+	this->assign_words(result);
+}
+
+void Integer::multiply_ntt(const Integer & n1, const Integer & n2) {
+
+	//Check precondition
+	#ifdef DEBUG
+		assert(n1._words.size() + n2._words.size() <= ((size_t)1 << NTT_MAX_LOG));
+	#endif
+
+	std::vector<int32_t> result(n1._words.size() + n2._words.size());
+
+	ntt_multiply(result.data(), n1._words.data(), n1._words.size(),
+								n2._words.data(), n2._words.size(), Integer::_n_threads);
+
+	//Save result into the current Integer
+	this->assign_words(result);
+}
+
+void Integer::multiply_words(int32_t * r, const int32_t * a, size_t na,
+																const int32_t * b, size_t nb) {
+
+	const size_t min_words = MIN(na, nb);
+
+	if (min_words < Integer::_thresholds.karatsuba_multiply)
+		mul_basecase(r, a, na, b, nb);
+	else if (min_words >= Integer::_thresholds.ntt_multiply &&
+						na + nb <= ((size_t)1 << NTT_MAX_LOG))
+		ntt_multiply(r, a, na, b, nb, Integer::_n_threads);
+	else
+		mul_karatsuba_unbalanced(r, a, na, b, nb);
+}
+
+void Integer::multiply_batch(std::span<const Integer> a, std::span<const Integer> b,
+																std::span<Integer> out) {
+
+	if (a.size() != b.size() || a.size() != out.size())
+		throw std::invalid_argument("Operands and results batches must have the same size");
+
+	static size_t lanes;
+	static const batch_kernel kernel = select_batch_kernel(lanes);
+
+	//Pairs are grouped by the number of words of their largest operand
+	std::vector<size_t> groups[BATCH_MULTIPLY_MAX_WORDS + 1];
+
+	for (size_t i = 0; i < a.size(); i++) {
+		const size_t size = MAX(a[i]._words.size(), b[i]._words.size());
+
+		if (size <= BATCH_MULTIPLY_MAX_WORDS)
+			groups[size].push_back(i);
+		else
+			out[i].multiply(a[i], b[i]);
+	}
+
+	std::vector<uint64_t> words_a, words_b, words_r;
+
+	for (size_t n = 1; n <= BATCH_MULTIPLY_MAX_WORDS; n++) {
+		const std::vector<size_t> & group = groups[n];
+
+		words_a.resize(n * lanes);
+		words_b.resize(n * lanes);
+		words_r.resize(2 * n * lanes);
+
+		//Unused lanes of the last chunk multiply zeros
+		for (size_t first = 0; first < group.size(); first += lanes) {
+			const size_t used = MIN(lanes, group.size() - first);
+
+			std::fill(words_a.begin(), words_a.end(), 0);
+			std::fill(words_b.begin(), words_b.end(), 0);
+
+			for (size_t l = 0; l < used; l++) {
+				//Products are computed on the absolute values
+				const std::vector<int32_t> & wa = a[group[first + l]]._words;
+				const std::vector<int32_t> & wb = b[group[first + l]]._words;
+
+				for (size_t k = 0; k < wa.size(); k++)
+					words_a[k * lanes + l] = (uint64_t)wa[k];
+				for (size_t k = 0; k < wb.size(); k++)
+					words_b[k * lanes + l] = (uint64_t)wb[k];
+			}
+
+			kernel(words_r.data(), words_a.data(), words_b.data(), n);
+
+			for (size_t l = 0; l < used; l++) {
+				const size_t i = group[first + l];
+				Integer & r = out[i];
+
+				r.resize(2 * n);
+				for (size_t k = 0; k < 2 * n; k++)
+					r._words[k] = (int32_t)words_r[k * lanes + l];
+
+				r._negative = a[i].is_negative() ^ b[i].is_negative();
+				r.fix();
+				r._modified = true;
+			}
+		}
+	}
+}
+
+Integer Integer::product(std::span<const Integer> factors) {
+
+	if (factors.empty())
+		return Integer(1);
+
+	std::vector<Integer> children, parents;
+
+	product_level(factors, children, Integer::_n_threads);
+
+	while (children.size() > 1) {
+		product_level(children, parents, Integer::_n_threads);
+		children.swap(parents);
+	}
+
+	return children[0];
+}
+
+Integer::ProductTree::ProductTree(std::span<const Integer> leaves) {
+
+	if (leaves.empty())
+		throw std::invalid_argument("A product tree requires at least one leaf");
+
+	this->_levels.emplace_back(leaves.begin(), leaves.end());
+
+	while (this->_levels.back().size() > 1) {
+		std::vector<Integer> parents;
+
+		product_level(this->_levels.back(), parents, Integer::_n_threads);
+		this->_levels.push_back(std::move(parents));
+	}
+}
+
+void Integer::Accumulator::add_words(const Integer & n, bool subtract) {
+
+	if (this->_lanes.size() < n._words.size())
+		this->_lanes.resize(n._words.size(), 0);
+
+	//Words hold the absolute value
+	if (subtract ^ n._negative)
+		for (size_t i = 0; i < n._words.size(); i++)
+			this->_lanes[i] -= n._words[i];
+	else
+		for (size_t i = 0; i < n._words.size(); i++)
+			this->_lanes[i] += n._words[i];
+
+	if (++this->_pending >= ACCUMULATOR_MAX_PENDING)
+		this->normalize();
+}
+
+void Integer::Accumulator::fold_small() {
+
+	//Split into 31 bits words, the most significant one keeps the sign
+	const size_t n_words = 5;
+
+	if (this->_lanes.size() < n_words)
+		this->_lanes.resize(n_words, 0);
+
+	__int128 value = this->_small;
+
+	for (size_t i = 0; i < n_words - 1; i++) {
+		this->_lanes[i] += (int64_t)(value & 0x7fffffff);
+		value >>= 31;
+	}
+
+	this->_lanes[n_words - 1] += (int64_t)value;
+	this->_small = 0;
+
+	if (++this->_pending >= ACCUMULATOR_MAX_PENDING)
+		this->normalize();
+}
+
+void Integer::Accumulator::normalize() {
+
+	int64_t carry = 0;
+
+	for (size_t i = 0; i < this->_lanes.size(); i++) {
+		carry += this->_lanes[i];
+		this->_lanes[i] = carry & 0x7fffffff;
+		carry >>= 31;
+	}
+
+	while (carry != 0 && carry != -1) {
+		this->_lanes.push_back(carry & 0x7fffffff);
+		carry >>= 31;
+	}
+
+	if (carry == -1)
+		this->_lanes.push_back(-1);
+
+	this->_pending = 1;
+}
+
+Integer::Accumulator & Integer::Accumulator::merge(const Accumulator & other) {
+
+	//Carries of the current lanes are propagated so the sum cannot overflow
+	this->normalize();
+
+	if (this->_lanes.size() < other._lanes.size())
+		this->_lanes.resize(other._lanes.size(), 0);
+
+	for (size_t i = 0; i < other._lanes.size(); i++)
+		this->_lanes[i] += other._lanes[i];
+
+	this->_pending += other._pending;
+	this->add_small(other._small);
+
+	if (this->_pending >= ACCUMULATOR_MAX_PENDING)
+		this->normalize();
+
+	return *this;
+}
+
+Integer Integer::Accumulator::result() const {
+
+	Accumulator sum(*this);
+
+	sum.fold_small();
+	sum.normalize();
+
+	//Lanes hold the sum in two's complement, the most significant one is -1 on negative sums
+	Integer ret;
+
+	ret._words.assign(sum._lanes.begin(), sum._lanes.end());
+	ret._negative = false;
+
+	if (!ret._words.empty() && ret._words.back() < 0) {
+		ret._words.pop_back();
+		ret.complement_words();
+	}
+
+	ret.fix();
+
+	return ret;
+}
+
+Integer::MontgomeryContext::MontgomeryContext(const Integer & mod) {
+
+	if (mod.is_negative() || mod.is_even() || mod.compare(1) == 0)
+		throw std::invalid_argument("Montgomery modulus must be odd and greater than 1");
+
+	const size_t n = mod._words.size();
+
+	this->_m.assign(mod._words.begin(), mod._words.end());
+	this->_m_inv = montgomery_inverse((uint32_t)this->_m[0]);
+
+	//R mod m and R^2 mod m are computed once through the general division
+	Integer one = (Integer(1) << (size_t)(N_BITS_PER_WORD * n)) % mod;
+	Integer r2 = (Integer(1) << (size_t)(2 * N_BITS_PER_WORD * n)) % mod;
+
+	this->_one.assign(n, 0);
+	this->_r2.assign(n, 0);
+	std::copy(one._words.begin(), one._words.end(), this->_one.begin());
+	std::copy(r2._words.begin(), r2._words.end(), this->_r2.begin());
+}
+
+Integer Integer::MontgomeryContext::modulus() const {
+
+	std::vector<int32_t> words(this->_m);
+	Integer m;
+
+	m.assign_words(words);
+
+	return m;
+}
+
+void Integer::MontgomeryContext::load(int32_t * r, const Integer & a) const {
+
+	const size_t n = this->_m.size();
+
+	std::fill(r, r + n, 0);
+
+	//Values already reduced are copied as they are
+	if (!a.is_negative() && compare_words(a._words.data(), a._words.size(), this->_m.data(), n) < 0)
+		std::copy(a._words.begin(), a._words.end(), r);
+	else {
+		const Integer m = this->modulus();
+		Integer reduced = a % m;
+
+		if (reduced.is_negative())
+			reduced += m;
+
+		std::copy(reduced._words.begin(), reduced._words.end(), r);
+	}
+}
+
+Integer Integer::MontgomeryContext::to_montgomery(const Integer & a) const {
+
+	const size_t n = this->_m.size();
+	std::vector<int32_t> words(n), ws(montgomery_workspace(n));
+
+	this->load(words.data(), a);
+	montgomery_mul(words.data(), words.data(), this->_r2.data(), this->_m.data(), n,
+									this->_m_inv, ws.data());
+
+	Integer ret;
+	ret.assign_words(words);
+
+	return ret;
+}
+
+Integer Integer::MontgomeryContext::from_montgomery(const Integer & a) const {
+
+	//Precondition
+	#ifdef DEBUG
+		assert(!a.is_negative() && compare_words(a._words.data(), a._words.size(), this->_m.data(), this->_m.size()) < 0);
+	#endif
+
+	const size_t n = this->_m.size();
+	std::vector<int32_t> words(n), one(n, 0), ws(montgomery_workspace(n));
+
+	//a/R = a*1/R
+	one[0] = 1;
+	this->load(words.data(), a);
+	montgomery_mul(words.data(), words.data(), one.data(), this->_m.data(), n,
+									this->_m_inv, ws.data());
+
+	Integer ret;
+	ret.assign_words(words);
+
+	return ret;
+}
+
+Integer Integer::MontgomeryContext::multiply(const Integer & a, const Integer & b) const {
+
+	//Precondition
+	#ifdef DEBUG
+		assert(!a.is_negative() && compare_words(a._words.data(), a._words.size(), this->_m.data(), this->_m.size()) < 0);
+		assert(!b.is_negative() && compare_words(b._words.data(), b._words.size(), this->_m.data(), this->_m.size()) < 0);
+	#endif
+
+	const size_t n = this->_m.size();
+	std::vector<int32_t> wa(n), wb(n), ws(montgomery_workspace(n));
+
+	this->load(wa.data(), a);
+	this->load(wb.data(), b);
+	montgomery_mul(wa.data(), wa.data(), wb.data(), this->_m.data(), n, this->_m_inv, ws.data());
+
+	Integer ret;
+	ret.assign_words(wa);
+
+	return ret;
+}
+
+void Integer::MontgomeryContext::power_words(int32_t * r, const int32_t * base,
+																							const Integer & exp) const {
+
+	const size_t n = this->_m.size();
+	const int32_t * m = this->_m.data();
+	const size_t k = window_bits(exp.n_bits());
+
+	//Every buffer is allocated once: table of odd powers and workspace
+	std::vector<int32_t> table(n << (k - 1)), square(n);
+	std::vector<int32_t> ws(montgomery_workspace(n));
+
+	//table[i] = base^(2i+1) in Montgomery form
+	std::copy(base, base + n, table.begin());
+
+	if (k > 1) {
+		montgomery_mul(square.data(), table.data(), table.data(), m, n, this->_m_inv, ws.data());
+
+		for (size_t i = 1; i < ((size_t)1 << (k - 1)); i++)
+			montgomery_mul(table.data() + i * n, table.data() + (i - 1) * n, square.data(), m, n,
+											this->_m_inv, ws.data());
+	}
+
+	//base^0 = R mod m in Montgomery form
+	std::copy(this->_one.begin(), this->_one.end(), r);
+
+	sliding_window(exp._words.data(), exp._words.size(), k,
+		[&](size_t i) {std::copy(table.data() + i * n, table.data() + (i + 1) * n, r);},
+		[&]() {montgomery_mul(r, r, r, m, n, this->_m_inv, ws.data());},
+		[&](size_t i) {montgomery_mul(r, r, table.data() + i * n, m, n, this->_m_inv, ws.data());});
+}
+
+Integer Integer::MontgomeryContext::power(const Integer & base, const Integer & exp) const {
+
+	//Precondition
+	if (exp.is_negative())
+		throw std::invalid_argument("exp must be positive or 0");
+
+	const size_t n = this->_m.size();
+	std::vector<int32_t> words(n), one(n, 0), ws(montgomery_workspace(n));
+
+	//Base is taken into Montgomery form and the result out of it
+	this->load(words.data(), base);
+	montgomery_mul(words.data(), words.data(), this->_r2.data(), this->_m.data(), n,
+									this->_m_inv, ws.data());
+
+	this->power_words(words.data(), words.data(), exp);
+
+	one[0] = 1;
+	montgomery_mul(words.data(), words.data(), one.data(), this->_m.data(), n,
+									this->_m_inv, ws.data());
+
+	Integer ret;
+	ret.assign_words(words);
+
+	return ret;
+}
+
+Integer::BarrettContext::BarrettContext(const Integer & mod) {
+
+	if (mod.is_zero())
+		throw zero_division_error();
+
+	if (mod.is_negative())
+		throw std::invalid_argument("Barrett modulus must be positive");
+
+	const size_t n = mod._words.size();
+
+	this->_n = n;
+	this->_m.assign(n + 1, 0);
+	std::copy(mod._words.begin(), mod._words.end(), this->_m.begin());
+
+	/*mu has n+1 words but for the moduli being a power of 2^31, where it is
+	 *bounded to 2^(31(n+1)) - 1. It makes the quotient 1 lower as max, which
+	 *the correction absorbs */
+	Integer mu = (Integer(1) << (size_t)(2 * N_BITS_PER_WORD * n)) / mod;
+
+	if (mu._words.size() <= n + 1) {
+		this->_mu.assign(n + 1, 0);
+		std::copy(mu._words.begin(), mu._words.end(), this->_mu.begin());
+	}
+	else
+		this->_mu.assign(n + 1, 0x7fffffff);
+}
+
+Integer Integer::BarrettContext::modulus() const {
+
+	std::vector<int32_t> words(this->_m);
+	Integer m;
+
+	m.assign_words(words);
+
+	return m;
+}
+
+size_t Integer::BarrettContext::workspace() const {
+
+	const size_t n = this->_n;
+
+	//Layout: product (2n) | q (2n+2) | r2 (n+1) | t (n+1) | Karatsuba workspace,
+	//sized for the lowest threshold so thresholds changed meanwhile cannot overflow it
+	return 6 * n + 4 + MAX(karatsuba_workspace(n, 2), karatsuba_workspace(n + 1, 2));
+}
+
+void Integer::BarrettContext::reduce_words(int32_t * r, const int32_t * x, int32_t * ws) const {
+
+	const size_t n = this->_n;
+	const int32_t * m = this->_m.data();
+	int32_t * q = ws + 2 * n, * r2 = q + 2 * n + 2, * t = r2 + n + 1, * next = t + n + 1;
+
+	//q = floor(x / 2^(31(n-1))) * mu, whose words over n+1 underestimate x/m by 3 as max
+	mul_karatsuba(q, x + n - 1, this->_mu.data(), n + 1, next);
+
+	//x - floor(q / 2^(31(n+1)))*m is lower than 4m, so it is computed mod 2^(31(n+1))
+	Integer::mul_low_words(r2, q + n + 1, m, n + 1);
+	sub_words(t, x, n + 1, r2, n + 1);
+
+	while (compare_words(t, n + 1, m, n) >= 0)
+		sub_words(t, t, n + 1, m, n);
+
+	std::copy(t, t + n, r);
+}
+
+void Integer::BarrettContext::mulmod_words(int32_t * r, const int32_t * a, const int32_t * b,
+																						int32_t * ws) const {
+
+	const size_t n = this->_n;
+
+	//The product is written at the beginning of the workspace, before the reduction buffers
+	mul_karatsuba(ws, a, b, n, ws + 6 * n + 4);
+	this->reduce_words(r, ws, ws);
+}
+
+void Integer::BarrettContext::load(int32_t * r, const Integer & a) const {
+
+	const size_t n = this->_n;
+
+	std::fill(r, r + n, 0);
+
+	//Values already reduced are copied as they are
+	if (!a.is_negative() && compare_words(a._words.data(), a._words.size(), this->_m.data(), n) < 0)
+		std::copy(a._words.begin(), a._words.end(), r);
+	else {
+		const Integer reduced = this->reduce(a);
+		std::copy(reduced._words.begin(), reduced._words.end(), r);
+	}
+}
+
+Integer Integer::BarrettContext::reduce(const Integer & a) const {
+
+	const size_t n = this->_n;
+	const int32_t * w = a._words.data();
+	const size_t na = a._words.size();
+
+	std::vector<int32_t> r(n, 0);
+
+	if (compare_words(w, na, this->_m.data(), n) < 0)
+		std::copy(w, w + na, r.begin());
+	else {
+		std::vector<int32_t> x(2 * n), ws(this->workspace());
+
+		//Horner scheme by chunks of n words: r = (r*2^(31n) + chunk) mod m
+		for (size_t s = ((na - 1) / n) * n;; s -= n) {
+			std::fill(x.begin(), x.end(), 0);
+			std::copy(w + s, w + MIN(s + n, na), x.begin());
+			std::copy(r.begin(), r.end(), x.begin() + n);
+
+			this->reduce_words(r.data(), x.data(), ws.data());
+
+			if (s == 0)
+				break;
+		}
+	}
+
+	//Negative values are taken to [0, m)
+	if (a.is_negative() && std::any_of(r.begin(), r.end(), [](int32_t w) {return w != 0;}))
+		sub_words(r.data(), this->_m.data(), n, r.data(), n);
+
+	Integer ret;
+	ret.assign_words(r);
+
+	return ret;
+}
+
+Integer Integer::BarrettContext::mulmod(const Integer & a, const Integer & b) const {
+
+	const size_t n = this->_n;
+	std::vector<int32_t> wa(n), wb(n), ws(this->workspace());
+
+	this->load(wa.data(), a);
+	this->load(wb.data(), b);
+	this->mulmod_words(wa.data(), wa.data(), wb.data(), ws.data());
+
+	Integer ret;
+	ret.assign_words(wa);
+
+	return ret;
+}
+
+Integer Integer::BarrettContext::sqrmod(const Integer & a) const {
+
+	const size_t n = this->_n;
+	std::vector<int32_t> wa(n), ws(this->workspace());
+
+	this->load(wa.data(), a);
+	this->mulmod_words(wa.data(), wa.data(), wa.data(), ws.data());
+
+	Integer ret;
+	ret.assign_words(wa);
+
+	return ret;
+}
+
+Integer Integer::BarrettContext::addmod(const Integer & a, const Integer & b) const {
+
+	const size_t n = this->_n;
+	std::vector<int32_t> wa(n + 1), wb(n);
+
+	this->load(wa.data(), a);
+	this->load(wb.data(), b);
+
+	//a + b < 2m, so a single subtraction reduces it
+	wa[n] = add_words(wa.data(), wa.data(), n, wb.data(), n);
+
+	if (compare_words(wa.data(), n + 1, this->_m.data(), n) >= 0)
+		sub_words(wa.data(), wa.data(), n + 1, this->_m.data(), n);
+
+	Integer ret;
+	ret.assign_words(wa);
+
+	return ret;
+}
+
+void Integer::BarrettContext::power_words(int32_t * r, const int32_t * base,
+																						const Integer & exp) const {
+
+	const size_t n = this->_n;
+	const size_t k = window_bits(exp.n_bits());
+
+	//Every buffer is allocated once: table of odd powers and workspace
+	std::vector<int32_t> table(n << (k - 1)), square(n);
+	std::vector<int32_t> ws(this->workspace());
+
+	//table[i] = base^(2i+1) mod m
+	std::copy(base, base + n, table.begin());
+
+	if (k > 1) {
+		this->mulmod_words(square.data(), table.data(), table.data(), ws.data());
+
+		for (size_t i = 1; i < ((size_t)1 << (k - 1)); i++)
+			this->mulmod_words(table.data() + i * n, table.data() + (i - 1) * n, square.data(), ws.data());
+	}
+
+	//base^0 = 1 mod m
+	this->load(r, 1);
+
+	sliding_window(exp._words.data(), exp._words.size(), k,
+		[&](size_t i) {std::copy(table.data() + i * n, table.data() + (i + 1) * n, r);},
+		[&]() {this->mulmod_words(r, r, r, ws.data());},
+		[&](size_t i) {this->mulmod_words(r, r, table.data() + i * n, ws.data());});
+}
+
+Integer Integer::BarrettContext::power(const Integer & base, const Integer & exp) const {
+
+	//Precondition
+	if (exp.is_negative())
+		throw std::invalid_argument("exp must be positive or 0");
+
+	std::vector<int32_t> words(this->_n);
+
+	this->load(words.data(), base);
+	this->power_words(words.data(), words.data(), exp);
+
+	Integer ret;
+	ret.assign_words(words);
+
+	return ret;
+}
+
+void Integer::mul_low_words(int32_t * r, const int32_t * a, const int32_t * b, size_t n) {
+
+	if (n < Integer::_thresholds.short_product) {
+		mul_low_basecase(r, a, b, n);
+		return;
+	}
+
+	/* Mulders' short product: a full product of the k less significant words
+	 * plus two low short products of h words for the crossed terms. Taking k
+	 * about 0.7n is optimal for Karatsuba multiplication */
+	const size_t h = n * 3 / 10;
+	const size_t k = n - h;
+
+	std::vector<int32_t> full(2 * k), cross(h);
+
+	multiply_words(full.data(), a, k, b, k);
+	std::copy(full.begin(), full.begin() + n, r);
+
+	for (size_t t = 0; t < 2; t++) {
+
+		if (t == 0)
+			mul_low_words(cross.data(), a + k, b, h);
+		else
+			mul_low_words(cross.data(), a, b + k, h);
+
+		//Add crossed terms at word k, carry over the word n is dropped
+		uint64_t carry = 0;
+		for (size_t i = 0; i < h; i++) {
+			carry += (uint64_t)r[k + i] + (uint64_t)cross[i];
+			r[k + i] = (int32_t)(carry & 0x7fffffff);
+			carry >>= 31;
+		}
+	}
+}
+
+void Integer::mul_high_words(int32_t * r, const int32_t * a, const int32_t * b, size_t n) {
+
+	if (n < Integer::_thresholds.short_product) {
+		mul_high_basecase(r, a, b, n);
+		return;
+	}
+
+	/* Mulders' short product: a full product of the k most significant words
+	 * plus two high short products of h words for the crossed terms. Words
+	 * discarded on every level underestimate the result by 5 as max */
+	const size_t h = n * 3 / 10;
+	const size_t k = n - h;
+
+	std::vector<int32_t> full(2 * k), cross(h);
+
+	multiply_words(full.data(), a + h, k, b + h, k);
+	std::copy(full.begin() + (k - h), full.end(), r);
+
+	for (size_t t = 0; t < 2; t++) {
+
+		if (t == 0)
+			mul_high_words(cross.data(), a + n - h, b, h);
+		else
+			mul_high_words(cross.data(), a, b + n - h, h);
+
+		uint64_t carry = 0;
+		for (size_t i = 0; i < n; i++) {
+			carry += (uint64_t)r[i] + (uint64_t)(i < h? cross[i] : 0);
+			r[i] = (int32_t)(carry & 0x7fffffff);
+			carry >>= 31;
+
+			if (carry == 0 && i >= h)
+				break;
+		}
+	}
+}
+
+Integer Integer::mul_low(const Integer & a, const Integer & b, size_t n) {
+
+	if (a.is_negative() || b.is_negative())
+		throw std::invalid_argument("Short product operands must be positive");
+
+	Integer result;
+
+	if (n == 0)
+		return result;
+
+	std::vector<int32_t> op1(n, 0), op2(n, 0), words(n);
+
+	std::copy(a._words.begin(), a._words.begin() + MIN(n, a._words.size()), op1.begin());
+	std::copy(b._words.begin(), b._words.begin() + MIN(n, b._words.size()), op2.begin());
+
+	Integer::mul_low_words(words.data(), op1.data(), op2.data(), n);
+	result.assign_words(words);
+
+	//Check postcondition
+	#ifdef DEBUG
+		assert(result.compare(Integer::abs(result)) == 0);
+		assert(result.n_bits() <= N_BITS_PER_WORD * n);
+	#endif
+
+	return result;
+}
+
+Integer Integer::mul_high(const Integer & a, const Integer & b, size_t n) {
+
+	if (a.is_negative() || b.is_negative())
+		throw std::invalid_argument("Short product operands must be positive");
+
+	if ((!a.is_zero() && a.n_bits() > N_BITS_PER_WORD * n) ||
+				(!b.is_zero() && b.n_bits() > N_BITS_PER_WORD * n))
+		throw std::invalid_argument("Short product operands exceed the number of words");
+
+	Integer result;
+
+	if (n == 0)
+		return result;
+
+	std::vector<int32_t> op1(n, 0), op2(n, 0), words(n);
+
+	std::copy(a._words.begin(), a._words.end(), op1.begin());
+	std::copy(b._words.begin(), b._words.end(), op2.begin());
+
+	Integer::mul_high_words(words.data(), op1.data(), op2.data(), n);
+	result.assign_words(words);
+
+	return result;
+}
+
+Integer Integer::mul_mid(const Integer & a, const Integer & b, size_t n) {
+
+	if (a.is_negative() || b.is_negative())
+		throw std::invalid_argument("Middle product operands must be positive");
+
+	Integer result;
+
+	if (n == 0)
+		return result;
+
+	if ((!a.is_zero() && a.n_bits() > N_BITS_PER_WORD * (2 * n - 1)) ||
+				(!b.is_zero() && b.n_bits() > N_BITS_PER_WORD * n))
+		throw std::invalid_argument("Middle product operands exceed the number of words");
+
+	std::vector<int32_t> words(n + 2);
+
+	if (n < Integer::_thresholds.short_product) {
+		std::vector<int32_t> op1(2 * n - 1, 0), op2(n, 0);
+
+		std::copy(a._words.begin(), a._words.end(), op1.begin());
+		std::copy(b._words.begin(), b._words.end(), op2.begin());
+
+		mul_mid_basecase(words.data(), op1.data(), op2.data(), n);
+	}
+	else {
+		std::vector<__int128> x(2 * n - 1, 0), y(n, 0), c(n);
+
+		std::copy(a._words.begin(), a._words.end(), x.begin());
+		std::copy(b._words.begin(), b._words.end(), y.begin());
+
+		mul_mid_coefficients(c.data(), x.data(), y.data(), n);
+
+		//Coefficients are turned into words by propagating their carries
+		__int128 carry = 0;
+		for (size_t k = 0; k < n + 2; k++) {
+			carry += k < n? c[k] : 0;
+			words[k] = (int32_t)(carry & 0x7fffffff);
+			carry >>= 31;
+		}
+	}
+
+	result.assign_words(words);
+
+	return result;
+}
+
+void Integer::assign_words(std::vector<int32_t> & words, bool negative) {
+
+	//Words are copied when they fit, so the reserved capacity is kept
+	if (words.size() <= this->_words.capacity())
+		this->_words.assign(words.begin(), words.end());
+	else
+		this->_words.swap(words);
+
+	this->_negative = negative;
+
+	this->fix();
+	this->_modified = true;
+}
+
+void Integer::accumulate_words(const int32_t * p, size_t np, bool subtract) {
+
+	//Redundant words of p are skipped
+	while (np > 0 && p[np - 1] == 0)
+		np--;
+
+	if (np > this->_words.size())
+		this->resize(np);
+
+	int32_t * words = this->_words.data();
+	const size_t n = this->_words.size();
+
+	if (subtract == this->_negative) {
+		//Same signs, so the magnitudes are added
+		if (add_words(words, words, n, p, np) != 0) {
+			this->resize(n + 1);
+			this->_words.back() = 1;
+		}
+	}
+	else if (sub_words(words, words, n, p, np) != 0) {
+		//p was greater, so the sign turns into the p one
+		this->complement_words();
+	}
+
+	this->fix();
+	this->_modified = true;
+}
+
+void Integer::increment() {
+
+	const int32_t one = 1;
+
+	//Carry (or borrow on negative values) stops at the first word not overflowing
+	this->accumulate_words(&one, 1, false);
+}
+
+void Integer::decrement() {
+
+	const int32_t one = 1;
+
+	//Borrow (or carry on negative values) stops at the first word not overflowing
+	this->accumulate_words(&one, 1, true);
+}
+
+void Integer::add_scalar(unsigned __int128 m, bool subtract) {
+
+	//Words of the scalar are laid out on the stack
+	int32_t words[SCALAR_MAX_WORDS];
+	size_t n_words = 0;
+
+	for (; m != 0; m >>= 31)
+		words[n_words++] = (int32_t)(m & 0x7fffffff);
+
+	this->accumulate_words(words, n_words, subtract);
+}
+
+void Integer::multiply_scalar(unsigned __int128 m, bool negative) {
+
+	size_t k = 0;
+
+	for (unsigned __int128 aux = m; aux != 0; aux >>= 31)
+		k++;
+
+	const size_t n = this->_words.size();
+	const size_t n_result = n + k;
+
+	this->resize(n_result);
+
+	/* m = m1*2^62 + m0, so the partial products of m1 are placed two words
+	 * over the ones of m0 and every step fits in 128 bits */
+	const unsigned __int128 m0 = m & (((unsigned __int128)1 << 62) - 1), m1 = m >> 62;
+
+	unsigned __int128 carry = 0;
+	uint64_t previous1 = 0, previous2 = 0;
+
+	for (size_t i = 0; i < n_result; i++) {
+		const uint64_t word = i < n? (uint64_t)this->_words[i] : 0;
+
+		carry += word * m0 + previous2 * m1;
+		previous2 = previous1;
+		previous1 = word;
+
+		this->_words[i] = (int32_t)(carry & 0x7fffffff);
+		carry >>= 31;
+	}
+
+	#ifdef DEBUG
+		assert(carry == 0);
+	#endif
+
+	this->_negative ^= negative;
+
+	this->fix();
+	this->_modified = true;
+}
+
+void Integer::accumulate_scalar_product(const Integer & a, uint64_t m, bool subtract) {
+
+	//Signs decide whether the magnitude of the product is added or subtracted
+	const bool negative = (subtract ^ a.is_negative()) != this->is_negative();
+	const size_t na = a._words.size();
+
+	//|a|*m takes na+3 words as max, plus one extra word for the carry
+	const size_t n = MAX(this->_words.size(), na + 3) + 1;
+
+	this->resize(n);
+
+	unsigned __int128 product = 0;
+	int64_t carry = 0;
+	size_t i;
+
+	for (i = 0; i < n; i++) {
+
+		//Words of a are read before writing the same word of the result
+		const uint64_t word = i < na? (uint64_t)a._words[i] : 0;
+
+		product += (unsigned __int128)word * m;
+
+		const int64_t product_word = (int64_t)(product & 0x7fffffff);
+		product >>= 31;
+
+		carry += (int64_t)this->_words[i] + (negative? -product_word : product_word);
+		this->_words[i] = (int32_t)(carry & 0x7fffffff);
+		carry >>= 31;
+
+		if (i >= na && product == 0 && carry == 0)
+			break;
+	}
+
+	//The product was greater on a subtraction, so the sign is flipped
+	if (carry < 0)
+		this->complement_words();
+
+	this->fix();
+	this->_modified = true;
+}
+
+void Integer::accumulate_product(const Integer & a, const Integer & b, bool subtract) {
+
+	// Prepare postcondition check
+	#ifdef DEBUG
+		Integer org(*this), a_org(a), b_org(b);
+	#endif
+
+	//Gets the absolute value of an Integer up to 2 words
+	auto scalar = [](const Integer & n) -> uint64_t {
+		return n._words.size() == 1? (uint64_t)n._words[0] :
+								(uint64_t)n._words[0] + ((uint64_t)n._words[1] << 31);
+	};
+
+	if (a._words.size() <= 2 || b._words.size() <= 2) {
+		const Integer & big = b._words.size() <= 2? a : b;
+		const Integer & small = b._words.size() <= 2? b : a;
+
+		this->accumulate_scalar_product(big, scalar(small), subtract ^ small.is_negative());
+	}
+	else {
+		static thread_local std::vector<int32_t> buffer;
+
+		//Products are computed on the absolute values of both operands
+		buffer.resize(a._words.size() + b._words.size());
+
+		multiply_words(buffer.data(), a._words.data(), a._words.size(),
+										b._words.data(), b._words.size());
+
+		this->accumulate_words(buffer.data(), buffer.size(),
+														subtract ^ a.is_negative() ^ b.is_negative());
+	}
+
+	// Check postcondition
+	#ifdef DEBUG
+		assert(this->compare(subtract? org - a_org * b_org : org + a_org * b_org) == 0);
+	#endif
+}
+
+void Integer::divide(const Integer & d, Integer & quotient, Integer & remainder) const{
+
+	// Keep original dividend value for postcondition check
+	#ifdef DEBUG
+		Integer original(*this);
+		Integer d_org(d);
+	#endif
+
+	//Zero divission by zero check
+	if (d.is_zero()) {
+		throw zero_division_error();
+	}
+
+	const bool org_sign = this->is_negative();
+	const bool sign = this->is_negative() ^ d.is_negative();
+
+	const size_t na = this->_words.size(), nb = d._words.size();
+
+	//Operation is performed on the absolute values
+	if (compare_words(this->_words.data(), na, d._words.data(), nb) < 0) {
+		//|this| < |d| so quotient is 0 and remainder keeps the current value
+		remainder = *this;
+		quotient.reset();
+	}
+	else {
+		/*Quotient and remainder are computed on words buffers and normalized
+		 *once they are stored, so the current Integer and d can be passed as
+		 *quotient or remainder */
+		std::vector<int32_t> q(na - nb + 1), r(nb);
+
+		divide_words(q.data(), r.data(), this->_words.data(), na, d._words.data(), nb);
+
+		//Quotient takes the sign of the division, remainder the dividend one
+		quotient.assign_words(q, sign);
+		remainder.assign_words(r, org_sign);
+	}
+
+	//Check postcondition
+	#ifdef DEBUG
+		// original!= 0 => 0 <= remainder < this
+		assert(Integer::abs(remainder).compare(0) >= 0 && Integer::abs(remainder).compare(Integer::abs(d_org)) == -1);
+
+		// |original| < |d| => q == 0 and remainder == original
+		assert(!(Integer::abs(original).compare(Integer::abs(d_org)) == -1) ||
+											quotient.is_zero() && remainder.compare(original) == 0);
+
+		// On original = 0 => q = 0 and remainder == 0
+		assert(!original.is_zero() || (quotient.is_zero() && remainder.is_zero()));
+
+		// On original = d => q = 1 and remainder = 0
+		assert(!(original.compare(d_org) == 0) || (quotient.compare(1) == 0 && remainder.is_zero()));
+
+		// On d = 1 => original = q and remainder = 0
+		assert(!(d.compare(1) == 0) || (original.compare(quotient) == 0 && remainder.is_zero()));
+	#endif
+
+}
+
+void Integer::power(const Integer & exp) {
+
+	// Keep original dividend value for postcondition check
+	#ifdef DEBUG
+		Integer original(*this);
+	#endif
+
+	//Precondition
+	if (exp.is_negative())
+		throw std::invalid_argument("exp must be positive or 0");
+
+	//Sign of the result, which is negative on negative bases and odd exponents
+	const bool negative = this->_negative && !exp.is_even();
+
+	//0^exp = 0 and 1^exp = 1 for exp > 0, whatever the exponent size is
+	if (exp.is_zero()) {
+		this->reset();
+		this->_words[0] = 1;
+	}
+	else if (this->is_zero() || (this->_words.size() == 1 && this->_words[0] == 1))
+		this->_negative = negative;
+	else {
+		//Non trivial powers cannot be stored on exponents over the size_t range
+		if (exp.n_bits() > 8 * sizeof(size_t))
+			throw std::bad_alloc();
+
+		size_t e = 0;
+
+		for (size_t i = exp._words.size(); i-- > 0;)
+			e = (e << N_BITS_PER_WORD) | (size_t)exp._words[i];
+
+		const size_t n_bits = this->findFirstOne() + 1;
+
+		if (e > std::numeric_limits<size_t>::max() / n_bits)
+			throw std::bad_alloc();
+
+		//(2^s)^e is computed as a shift of 1 by s*e bits
+		const int32_t top = this->_words.back();
+		const bool power_of_two = (top & (top - 1)) == 0 &&
+								std::all_of(this->_words.begin(), this->_words.end() - 1,
+														[](int32_t w) {return w == 0;});
+
+		if (power_of_two) {
+			const size_t shift = (n_bits - 1) * e;
+
+			this->reset();
+			this->reserve(shift + 1);
+			this->_words[0] = 1;
+			this->bitwise_shift_left(shift);
+			this->_negative = negative;
+		}
+		else
+			this->power_window(exp, n_bits * e);
+	}
+
+	//Check postcondition
+	#ifdef DEBUG
+		// On exp = 0 => this = 1
+		assert(!exp.is_zero() || this->compare(1) == 0);
+
+		// On original = 1 => this = 1
+		assert(!original.compare(1) == 0 || this->compare(1) == 0);
+
+		// On original = 0 and exp != 0 => this = 0
+		assert(!(original.compare(0) == 0 && !exp.is_zero()) || this->compare(0) == 0);
+
+		// On original > 1 and exp > 1 => this > original
+		assert(!(original.compare(1) == 1 && exp.compare(1) == 1) ||
+																this->compare(original) == 1);
+
+		// On original < 0 and exp.is_even() => this > 0 and this >= -original
+		assert(!(original.compare(0) == -1 && exp.compare(1) == 1 && exp.is_even()) ||
+													(this->compare(0) == 1 && this->compare(-original) != -1));
+
+		// On original < 0 and ¬exp.is_even() => this < 0 and this <= original
+		assert(!(original.compare(0) == -1 && exp.compare(1) == 1 && !exp.is_even()) ||
+													(this->compare(0) == -1 && this->compare(original) != 1));
+	#endif
+
+	return;
+}
+
+void Integer::power_window(const Integer & exp, size_t n_bits_max) {
+
+	const size_t k = window_bits(exp.n_bits());
+
+	//Table of odd powers: table[i] = this^(2i+1)
+	std::vector<Integer> table((size_t)1 << (k - 1));
+	table[0] = *this;
+
+	if (table.size() > 1) {
+		Integer square;
+		square.multiply(*this, *this);
+
+		for (size_t i = 1; i < table.size(); i++)
+			table[i].multiply(table[i - 1], square);
+	}
+
+	/*	Every partial result is a power up to the result, so the na+nb words of
+	 *	its products fit in one word more than the result. Products are written
+	 *	into the spare buffer, which is then swapped with the result one */
+	const size_t n_words_max = n_bits_max / N_BITS_PER_WORD + 2;
+	std::vector<int32_t> result(n_words_max), product(n_words_max);
+	size_t n = 0;
+
+	auto multiply = [&](const int32_t * b, size_t nb) {
+		multiply_words(product.data(), result.data(), n, b, nb);
+		n += nb;
+
+		while (n > 1 && product[n - 1] == 0)
+			n--;
+
+		result.swap(product);
+	};
+
+	sliding_window(exp._words.data(), exp._words.size(), k,
+		[&](size_t i) {
+			n = table[i]._words.size();
+			std::copy(table[i]._words.begin(), table[i]._words.end(), result.begin());
+		},
+		[&]() {multiply(result.data(), n);},
+		[&](size_t i) {multiply(table[i]._words.data(), table[i]._words.size());});
+
+	result.resize(n);
+	this->assign_words(result, this->_negative && !exp.is_even());
+}
 
 /**
-	*	Constant for easy and secure access to Integer words
+	*	@brief Unimodular 2x2 matrix M relating the operands (a, b) of a gcd to
+	*	their reduced values (a', b'), being (a, b) = M (a', b').
 */
-#define GETBLOCK(N,I) ((i)>=(N)._words.size() || (I)<0)? (N)._words[(I)] : ((I)>=(N)._words.size() && (N).is_negative()? -1 : 0)
+struct Integer::CofactorMatrix {
 
-//Initializes the random engine
-std::default_random_engine Integer::_random_engine(
-									std::chrono::system_clock::now().time_since_epoch().count());
+	Integer m[2][2] = {{1, 0}, {0, 1}};	///<- Matrix entries, by rows
+	bool negative = false;							///<- Whether the determinant is -1 instead of 1
 
-void Integer::fix() {
+	/**	@brief Right multiplies the matrix by [x y; z w], whose determinant is
+		*	-1 when negative_det is set, or 1 otherwise.
+	*/
+	void multiply(const Integer & x, const Integer & y, const Integer & z, const Integer & w,
+								bool negative_det) {
+
+		for (auto & row : this->m) {
+			Integer t = row[0] * x + row[1] * z;
+			row[1] = row[0] * y + row[1] * w;
+			row[0] = std::move(t);
+		}
 
-	if (_words.size() > 1) {
+		this->negative ^= negative_det;
+	}
 
-		/*	Find the first significant word (every word having 0 or -1 value
-		 *		at beginning is redundant, a non-significant word, so they must be
-		 *	removed) */
-		int i = _words.size()-1;
+	/**	@brief Right multiplies the matrix by n.
+	*/
+	void multiply(const CofactorMatrix & n) {
 
-		while (i>0 && (_words[i]==0 && !this->is_negative() ||
-										((_words[i]==-1 ||
-											_words[i]==INT32_MAX) && this->is_negative()) ) )
-			i--;
+		//The identity is just replaced, i.e when a reduction starts
+		if (this->m[0][1].is_zero() && this->m[1][0].is_zero() &&
+				this->m[0][0].compare(1) == 0 && this->m[1][1].compare(1) == 0) {
+			*this = n;
+			return;
+		}
 
-		resize(i+1);
+		this->multiply(n.m[0][0], n.m[0][1], n.m[1][0], n.m[1][1], n.negative);
 	}
-	else if (_words.empty()) {
-		resize(1);
-		_words.back() = 0;
+
+	/**	@brief Replaces (a, b) by M^-1 (a, b).
+	*/
+	void solve(Integer & a, Integer & b) const {
+
+		//M^-1 = det(M) [m11 -m01; -m10 m00]
+		Integer t = this->m[1][1] * a - this->m[0][1] * b;
+		b = this->m[0][0] * b - this->m[1][0] * a;
+		a = std::move(t);
+
+		if (this->negative) {
+			a.negative();
+			b.negative();
+		}
 	}
 
-	//Check postcondition
-	#ifdef DEBUG
-		assert(!(this->_words.size() > 1) || (this->_words.back() != 0 &&
-																									this->_words.back() != -1));
+	/**	@brief Restores a >= b >= 0 on the values given by solve, through sign
+		*	changes and swaps of the columns of M.
+	*/
+	void normalize(Integer & a, Integer & b) {
 
-		for (size_t i = 0; i < this->_words.size()-1; i++)
-			assert((this->_words[i] & 0x80000000) == 0);
-	#endif
+		for (size_t j = 0; j < 2; j++) {
+			Integer & x = j? b : a;
 
-	return;
-}
+			if (x.is_negative()) {
+				x.negative();
+				this->m[0][j].negative();
+				this->m[1][j].negative();
+				this->negative = !this->negative;
+			}
+		}
 
-void Integer::split(Integer & n1, Integer & n2, size_t part_size) const {
+		if (a.compare(b) < 0) {
+			std::swap(a, b);
+			std::swap(this->m[0][0], this->m[0][1]);
+			std::swap(this->m[1][0], this->m[1][1]);
+			this->negative = !this->negative;
+		}
+	}
+};
 
-	//Check precondition
-	#ifdef DEBUG
-		assert(part_size > 0);
-	#endif
+void Integer::lehmer_reduce(Integer & a, Integer & b, size_t n_bits, CofactorMatrix * M) {
 
-	//Extract the first word partition and stores into n1
-	n1._words.clear();
-	if (part_size < this->_words.size())
-		n1._words.insert( n1._words.begin(), this->_words.begin(),
-																					this->_words.begin() + part_size );
-	else
-		n1._words.insert( n1._words.begin(), this->_words.begin(),
-																													this->_words.end());
-	n1.fix();
-
-	//Extract the second word partition (remain words) and store into n2
-	n2._words.clear();
-	if (n1._words.size() == this->_words.size())
-		n2._words.push_back(0);
-	else
-		n2._words.insert( n2._words.begin(), this->_words.begin() + part_size,
-																												this->_words.end() );
-	n2.fix();
+	//Matrix of the steps taken, by rows. Its entries are positive
+	std::vector<int32_t> u(a._words), v(b._words), q, w[2][2] = {{{1}, {0}}, {{0}, {1}}};
+	bool negative = false;
 
-	//Check postcondition
-	#ifdef DEBUG
-		assert(!(part_size <= this->_words.size()) ||
-								(n1._words.size() <= part_size &&
-								n2._words.size() <= MAX(this->_words.size() - n1._words.size(), 1)));
-	#endif
+	while (bits_words(v.data(), v.size()) > n_bits) {
 
-}
+		int64_t A, B, C, D;
 
-void Integer::add(const Integer & n1, int32_t n2, size_t index) {
+		if (u.size() > 2 && lehmer_matrix(u.data(), u.size(), v.data(), v.size(), A, B, C, D)) {
+			v.resize(u.size(), 0);
+			lehmer_apply(u.data(), v.data(), u.size(), A, B, C, D);
+			trim_words(u);
+			trim_words(v);
 
-	//Check the precondition
-	#ifdef DEBUG
-		assert(index >= 0 && index < n1._words.size());
-	#endif
+			//The previous operands are L^-1 = det(L) [D -B; -C A] times the new ones
+			if (M) {
+				const bool negative_det = (__int128)A * D < (__int128)B * C;
+				const int64_t s = negative_det? -1 : 1;
 
-	int64_t carry = n2;
+				for (auto & row : w) {
+					const size_t n = MAX(row[0].size(), row[1].size()) + 2;
 
-	//Add cumulated carry computed in every partial addition
-	size_t i;
-	for (i = index; i < n1._words.size(); i++) {
+					row[0].resize(n, 0);
+					row[1].resize(n, 0);
+					lehmer_apply(row[0].data(), row[1].data(), n, s * D, -s * C, -s * B, s * A);
+					trim_words(row[0]);
+					trim_words(row[1]);
+				}
+
+				negative ^= negative_det;
+			}
+		}
+		else {
+			euclid_step(u, v, q);
+
+			//The previous operands are [q 1; 1 0] times the new ones
+			if (M) {
+				Integer quotient;
+				quotient.assign_words(q);
+
+				for (auto & row : w) {
+					Integer x, y;
+					x.assign_words(row[0]);
+					y.assign_words(row[1]);
+
+					row[0] = (quotient * x + y)._words;
+					row[1] = x._words;
+				}
+
+				negative = !negative;
+			}
+		}
+	}
 
-		//Add carry cumulated to each n1 Integer word
-		carry += n1._words[i];
+	a.assign_words(u);
+	b.assign_words(v);
 
-		//	Extracts word from the carry and allocates an extra word is needed
-		if (i >= this->_words.size())
-			this->resize(i + 1);
+	if (M) {
+		CofactorMatrix L;
 
-		this->_words[i] = ((int32_t)carry & (int32_t)0x7fffffff);
+		for (size_t i = 0; i < 2; i++)
+			for (size_t j = 0; j < 2; j++)
+				L.m[i][j].assign_words(w[i][j]);
 
-		carry>>=31;
+		L.negative = negative;
+		M->multiply(L);
 	}
+}
+
+void Integer::half_gcd(Integer & a, Integer & b, CofactorMatrix * M) {
 
-	//Remove redundant remain words
-	if (i < this->_words.size())
-		this->resize(i);
+	const size_t n_bits = bits_words(a._words.data(), a._words.size()) / 2;
 
-	//Extract last word
-	if (carry != 0 && carry != -1) {
-			this->resize(i + 1);
-			this->_words[i] = (carry & (int32_t)-1);
+	if (b._words.size() < Integer::_thresholds.hgcd) {
+		Integer::lehmer_reduce(a, b, n_bits, M);
+		return;
 	}
 
+	//Reduces the operands by the half-GCD of their bits above shift. Its matrix
+	//is a valid reduction of the whole operands up to a few steps, which are
+	//corrected afterwards through the signs and the final Lehmer steps. As the
+	//high bits are already reduced, the matrix is only applied to the low bits
+	auto reduce_high = [&](size_t shift) {
+		CofactorMatrix R;
+		Integer x = a >> shift, y = b >> shift;
+		Integer a_low = a - (x << shift), b_low = b - (y << shift);
 
-	if (carry < 0)
-		//Set the negative sign on the current Integer if needed
-		_words.back() |= 0x80000000;
+		Integer::half_gcd(x, y, &R);
+		R.solve(a_low, b_low);
+
+		a = (x << shift) + a_low;
+		b = (y << shift) + b_low;
+		R.normalize(a, b);
+
+		if (M)
+			M->multiply(R);
+	};
+
+	//The most significant half is reduced to a quarter, so the operands are
+	//reduced to three quarters
+	reduce_high(n_bits);
+
+	if (bits_words(b._words.data(), b._words.size()) > n_bits) {
+
+		//Division step, which also handles quotients too big for the half-GCD
+		Integer q, r;
+		a.divide(b, q, r);
+
+		a = std::move(b);
+		b = std::move(r);
+
+		if (M)
+			M->multiply(q, 1, 1, 0, true);
+
+		//The second half-GCD is taken on the bits above the position leaving
+		//about n_bits bits after the reduction
+		const size_t a_bits = bits_words(a._words.data(), a._words.size());
+
+		if (bits_words(b._words.data(), b._words.size()) > n_bits && 4 * a_bits <= 7 * n_bits)
+			reduce_high(2 * n_bits - a_bits);
+	}
+
+	Integer::lehmer_reduce(a, b, n_bits, M);
 }
 
-void Integer::add(const Integer & n1, const Integer & n2, bool negative) {
+void Integer::gcd_reduce(Integer & a, Integer & b, CofactorMatrix * M) {
+
+	//Every half-GCD halves the operands, leaving the second one about half the
+	//size of the first one, so a division step follows
+	while (b._words.size() >= Integer::_thresholds.hgcd) {
+		Integer q, r;
+
+		Integer::half_gcd(a, b, M);
+
+		if (b.is_zero())
+			break;
+
+		a.divide(b, q, r);
+		a = std::move(b);
+		b = std::move(r);
+
+		if (M)
+			M->multiply(q, 1, 1, 0, true);
+	}
+}
+
+Integer Integer::gcd(const Integer & a, const Integer & b) {
+
+	//Signs are ignored, gcd(a, b) = gcd(|a|, |b|)
+	std::vector<int32_t> u, v;
+
+	if (MIN(a._words.size(), b._words.size()) >= Integer::_thresholds.hgcd) {
+		Integer x = Integer::abs(a), y = Integer::abs(b);
+
+		if (x.compare(y) < 0)
+			std::swap(x, y);
+
+		Integer::gcd_reduce(x, y, nullptr);
+
+		u = x._words;
+		v = y._words;
+	}
+	else {
+		u = a._words;
+		v = b._words;
+	}
+
+	gcd_words(u, v);
+
+	Integer ret;
+	ret.assign_words(u);
 
+	//Check postcondition
 	#ifdef DEBUG
-		Integer n1_org(n1), n2_org(n2);
+		assert(!ret.is_negative());
+		assert(!(a.is_zero() && b.is_zero()) || ret.is_zero());
 	#endif
 
-	Integer result;
-	Integer n2_aux(n2);
+	return ret;
+}
+
+Integer Integer::lcm(const Integer & a, const Integer & b) {
+
+	if (a.is_zero() || b.is_zero())
+		return Integer();
+
+	//lcm(a, b) = |a| / gcd(a, b) * |b|, dividing first keeps the operands small
+	Integer ret = Integer::abs(a) / Integer::gcd(a, b);
+	ret *= Integer::abs(b);
 
-	if (negative == true)
-		n2_aux.negative();
+	return ret;
+}
 
-	size_t size;
+Integer Integer::gcdext(const Integer & a, const Integer & b, Integer & s) {
 
-	//Determine longer and shorter integer
-	const Integer & bigger = n1._words.size() >= n2._words.size()? n1 : n2_aux;
-	const Integer & smaller = n1._words.size() < n2._words.size()? n1 : n2_aux;
+	Integer x = Integer::abs(a), y = Integer::abs(b);
+	const bool swapped = x.compare(y) < 0;
 
-	size = smaller._words.size();
+	if (swapped)
+		std::swap(x, y);
 
-	//Perform addition block by block
-	size_t i(0);
+	//The operands are reduced to (g, 0) = M^-1 (x, y), so the cofactors of x
+	//and y are the first row of M^-1 = det(M) [m11 -m01; -m10 m00]
+	CofactorMatrix M;
 
-	result.add(bigger,smaller._words[i],i);
+	Integer::gcd_reduce(x, y, &M);
+	Integer::lehmer_reduce(x, y, 0, &M);
 
-	for (i=1; i<size;i++) {
-			result.add(result,smaller._words[i],i);
+	if (x.is_zero()) {
+		s = 0;
+		return x;
 	}
 
-	//Remove reduntant blocks
-	result.fix();
+	s = swapped? M.m[0][1] : M.m[1][1];
 
-	//Save result into the current Integer
-	this->_words.swap(result._words);
+	if (swapped != M.negative)
+		s.negative();
 
-	//Check postconditions
-	#ifdef DEBUG
-		// n1 + n2 = this => this >= n1 && this >= n2
-		assert( ((negative ^ n2_org.is_negative()) || n1_org.is_negative()) ||
-			(this->compare(n1_org) >= 0 && this->compare(Integer::abs(n2_org)) >= 0));
+	if (a.is_negative())
+		s.negative();
 
-		// n1 - n2 = this => this <= n1
-		assert( !(negative ^ n2_org.is_negative() && !n1_org.is_negative()) ||
-																			this->compare(n1_org) <= 0);
+	//Coefficients differ by multiples of |b| / g, the least one is taken
+	if (!b.is_zero()) {
+		const Integer n = Integer::abs(b) / x;
 
-		// n2 - n1 = this => this <= n2
-		assert( !(!(negative ^ n2_org.is_negative()) && n1_org.is_negative()) ||
-																			this->compare(Integer::abs(n2_org)) <= 0);
+		s %= n;
 
-		// - n1 - n2 = this => this <= n1 && this <= n
-		assert( !((negative ^ n2_org.is_negative()) && n1_org.is_negative()) ||
-			(this->compare(n1_org) <= 0 && this->compare(n2_org) <= 0));
+		if ((Integer::abs(s) << (size_t)1).compare(n) > 0)
+			s += s.is_negative()? n : -n;
+	}
 
-		// On n1 + 0 = this => n1 = this, on n1 - 0 = this => n1 = this
-		assert(! (n2_org.compare(0) == 0) || this->compare(n1_org) == 0);
+	return x;
+}
 
-		// On 0 + n2 = this => n2 = this, on 0 - n2 = this => -n2 = this
-		assert(! (n1_org.compare(0) == 0) ||
-								this->compare(n2_org) == 0 && !negative ||
-								this->compare(-n2_org) == 0 && negative);
+Integer Integer::gcdext(const Integer & a, const Integer & b, Integer & s, Integer & t) {
 
-		// When deduct, n1 < n2 => this < 0
-		assert(!((negative ^ n2_org.is_negative() && !n1_org.is_negative()) &&
-										n1_org.compare(Integer::abs(n2_org)) == -1) ||
-												(this->is_negative() && this->compare(0) == -1));
+	const Integer g = Integer::gcdext(a, b, s);
 
-		// When deduct, n1 == n2 => this == 0
-		assert(!((negative ^ n2_org.is_negative() ^ n1_org.is_negative()) &&
-											Integer::abs(n1_org).compare(Integer::abs(n2_org)) == 0) ||
-												(this->is_zero() && this->compare(0) == 0));
+	if (b.is_zero())
+		t = 0;
+	else
+		t = (g - s * a) / b;
 
-		// When deduct, n1 > n2 => this > 0
-		assert(!((negative ^ n2_org.is_negative()) && !n1_org.is_negative() &&
-												n1_org.compare(Integer::abs(n2_org)) == 1) ||
-										(!(this->is_zero() || this->is_negative())  &&
-											this->compare(0) == 1));
+	//Check postcondition
+	#ifdef DEBUG
+		assert(s * a + t * b == g);
 	#endif
+
+	return g;
 }
 
-void Integer::multiply(const Integer & n1, const Integer & n2) {
+Integer Integer::invert(const Integer & a, const Integer & m) {
 
-	// Prepare postcondition check
+	//Preconditions
+	if (m.is_zero())
+		throw zero_division_error();
+
+	if (m.is_negative())
+		throw std::invalid_argument("m must be positive");
+
+	//Values beyond the modulus are reduced beforehand
+	Integer s;
+	const Integer g = Integer::abs(a).compare(m) < 0? Integer::gcdext(a, m, s) :
+																										Integer::gcdext(a % m, m, s);
+
+	if (g.compare(1) != 0)
+		throw std::invalid_argument("Value is not invertible modulo m");
+
+	if (s.is_negative())
+		s += m;
+
+	//Check postcondition
 	#ifdef DEBUG
-		Integer n1_org(n1), n2_org(n2);
+		assert(s >= 0 && s < m);
 	#endif
 
-	const Integer minus(-1);
+	return s;
+}
 
-	//Product by 0
-	if (n1.is_zero() || n2.is_zero())
-		this->reset();
-	else if (n1 == minus) {
-		//Product -1 * n2
-		//Turn n2 into negative and store it into the current Integer
-		*this = n2;
-		this->negative();
-	}
-	else if (n2 == minus) {
-		// Product n1 * -1
-		//Turn n1 into negative and store it into the current Integer
-		*this = n1;
-		this->negative();
+void Integer::invert_batch(std::span<Integer> values, const Integer & m) {
+
+	//Preconditions
+	if (m.is_zero())
+		throw zero_division_error();
+
+	if (m.is_negative())
+		throw std::invalid_argument("m must be positive");
+
+	//Every value is 0 modulo 1, its own inverse
+	if (m.compare(1) == 0) {
+		std::fill(values.begin(), values.end(), Integer());
+		return;
 	}
-	else {
 
-		/****************************
-		 *	Algorithm of Karashutba *
-		*****************************/
+	if (values.empty())
+		return;
 
-		//Perform direct multiplication whether integer are small enough
-		if (n1._words.size() == 1 && n2._words.size() == 1) {
+	const size_t n = values.size();
+	size_t n_chunks = MIN(Integer::_n_threads, n);
 
-			/*The resulting Integer may take 64 bits as max so
-			* it's required to split it into 32 bits-blocks*/
+	if (n * m._words.size() < BATCH_INVERT_PARALLEL_WORDS)
+		n_chunks = 1;
 
-			int64_t result = ((int64_t)n1._words.back()) * n2._words.back();
+	//Values share the context of the modulus. prefix[i] is the product of the
+	//values from the beginning of the chunk of i up to i
+	const ModInteger zero(m);
+	std::vector<ModInteger> residues(n, zero), prefix(n, zero);
 
-			this->resize(2);
-			for (size_t i = 0; i < this->_words.size(); i++) {
-				this->_words[i] = (result & (int32_t)0x7fffffff);
-				result >>= 31;
-			}
+	auto chunk_begin = [&](size_t c) {return c * n / n_chunks;};
 
-			if (result < 0)
-				this->_words.back() |= 0x80000000;
+	parallel_for(0, n_chunks, n_chunks, [&](size_t c_lo, size_t c_hi) {
+		for (size_t c = c_lo; c < c_hi; c++)
+			for (size_t i = chunk_begin(c); i < chunk_begin(c + 1); i++) {
+				residues[i] = ModInteger(values[i], zero);
+				prefix[i] = i == chunk_begin(c)? residues[i] : prefix[i - 1] * residues[i];
+			}
+	});
 
-			this->fix();
+	//The products of the chunks are inverted the same way, through a single
+	//inversion, which throws before any value is modified
+	std::vector<ModInteger> chunk_prefix(n_chunks, zero), chunk_inverse(n_chunks, zero);
 
-		}
-		else {
-			//Integers are not small enough so a subdivision is performed
+	chunk_prefix[0] = prefix[chunk_begin(1) - 1];
 
-			//number of blocks of subdivisions
-			size_t size = MAX(n1._words.size() , n2._words.size());
-			size = (size/2) + (size%2);
+	for (size_t c = 1; c < n_chunks; c++)
+		chunk_prefix[c] = chunk_prefix[c - 1] * prefix[chunk_begin(c + 1) - 1];
 
+	ModInteger inverse = chunk_prefix[n_chunks - 1].inverse();
 
-			Integer w,x;
-			Integer y,z;
+	for (size_t c = n_chunks - 1; c > 0; c--) {
+		chunk_inverse[c] = inverse * chunk_prefix[c - 1];
+		inverse *= prefix[chunk_begin(c + 1) - 1];
+	}
 
-			Integer r;
-			Integer p;
-			Integer q;
+	chunk_inverse[0] = inverse;
 
-			//Splits operands into two sub-integers of size length
-			n1.split(x,w,size);
-			n2.split(z,y,size);
+	//Inverses are peeled off the prefix products backwards:
+	//1/v[i] = prefix[i-1] / prefix[i], 1/prefix[i-1] = v[i] / prefix[i]
+	parallel_for(0, n_chunks, n_chunks, [&](size_t c_lo, size_t c_hi) {
+		for (size_t c = c_lo; c < c_hi; c++) {
+			ModInteger inverse = chunk_inverse[c];
 
-			//Compute r, p y q recursively
-			r.multiply(w+x, y+z);
-			p.multiply(w,y);
-			q.multiply(x,z);
+			for (size_t i = chunk_begin(c + 1) - 1; i > chunk_begin(c); i--) {
+				values[i] = (inverse * prefix[i - 1]).value();
+				inverse *= residues[i];
+			}
 
-			/*Solve partial multiplication:
-			 *result = p*2^(tam*32) + (r-q-p)*2^(32*tam / 2) + q
-			 */
-			this->add((p<<(2*size*31)), ((r-p-q)<<(31*size)) );
-			this->add(*this, q);
+			values[chunk_begin(c)] = inverse.value();
 		}
+	});
+}
 
+void Integer::sqrtrem_karatsuba(const Integer & n, Integer & s, Integer & r) {
+
+	const size_t n_bits = bits_words(n._words.data(), n._words.size());
+
+	if (n_bits <= 64) {
+		const uint64_t value = shifted_bits(n._words.data(), n._words.size(), 0);
+		const uint64_t root = sqrt_native(value);
+
+		s = root;
+		r = value - root * root;
+		return;
 	}
 
-	// Check postcondition
-	#ifdef DEBUG
-		// On n1 > 1 and n2 > 1, this > n1 and this > n2
-		assert(!(n1_org.compare(1) == 1 && n2_org.compare(1) == 1) ||
-											(this->compare(n1_org) == 1 && this->compare(n2_org) == 1));
+	//n is shifted by an even number of bits to m = hi*b^2 + a1*b + a0, b = 2^k,
+	//with hi >= b^2 / 4, so the root of hi gives the high half of the root
+	const size_t k = (n_bits + 3) / 4, shift = (4 * k - n_bits) / 2;
+	const Integer m = n << (2 * shift);
+	const Integer mid = m >> k, hi = m >> (2 * k);
+	const Integer a1 = mid - (hi << k), a0 = m - (mid << k);
 
-		// On n1 == 1 => this == n2
-		assert(!(n1_org.compare(1) == 0) || (this->compare(n2_org) == 0));
+	Integer s1, r1, q, u;
+	Integer::sqrtrem_karatsuba(hi, s1, r1);
 
-		// On n2 == 1 => this == n1
-		assert(!(n2_org.compare(1) == 0) || (this->compare(n1_org) == 0));
+	//The low half of the root is the quotient of (r1*b + a1) / (2*s1), which
+	//exceeds it by a unit at most
+	((r1 << k) + a1).divide(s1 << (size_t)1, q, u);
 
-		// On n1 = 0 or n2 = 0, this = 0
-		assert(!(n1_org.compare(0) == 0 || n2_org.compare(0) == 0) ||
-											(this->is_zero() && this->compare(0) == 0));
+	s = (s1 << k) + q;
+	r = (u << k) + a0 - q * q;
 
-		// On n2 == -1 => this = -n1
-		assert( !(n2_org.compare(-1) == 0) || this->compare(-n1_org) == 0);
+	if (r.is_negative()) {
+		r += (s << (size_t)1) - 1;
+		s -= 1;
+	}
 
-		// On n1 == -1 => this = -n2
-		assert( !(n1_org.compare(-1) == 0) || this->compare(-n2_org) == 0);
+	//The root of n is the root of m shifted back, its remainder is recomputed
+	if (shift > 0) {
+		s >>= shift;
+		r = n - s * s;
+	}
+}
 
-		// On n1 < 0 ^ n2 < 0 => this <= 0
-		assert( !(n1_org.is_negative() ^ n2_org.is_negative()) || this->is_negative() || this->is_zero());
+Integer Integer::sqrtrem(const Integer & n, Integer & r) {
 
-		// On ¬ (n1_org < 0 ^ n2 < 0) => this >= 0
-		assert( (n1_org.is_negative() ^ n2_org.is_negative()) ||
-					( (!this->is_negative() || this->is_zero()) && this->compare(0) >= 0) );
+	//Precondition
+	if (n.is_negative())
+		throw std::invalid_argument("n must be positive or 0");
 
+	Integer s;
+	Integer::sqrtrem_karatsuba(n, s, r);
+
+	//Check postcondition
+	#ifdef DEBUG
+		assert(!r.is_negative() && r <= 2 * s);
+		assert(s * s + r == n);
 	#endif
 
-	return;
+	return s;
 }
 
-void Integer::divide(const Integer & d, Integer & quotient, Integer & remainder) const{
+Integer Integer::sqrt(const Integer & n) {
 
-	// Keep original dividend value for postcondition check
-	#ifdef DEBUG
-		Integer original(*this);
-		Integer d_org(d);
-	#endif
+	Integer r;
 
-	//Zero divission by zero check
-	if (d.is_zero()) {
-		throw zero_division_error();
-	}
+	return Integer::sqrtrem(n, r);
+}
 
-	bool org_sign = this->is_negative();
-	bool sign = this->is_negative() ^ d.is_negative();
+bool Integer::is_perfect_square(const Integer & n) {
 
-	Integer aux(d);
+	if (n.is_negative())
+		return false;
 
-	//Prepare operation
-	remainder = *this;
-	quotient.reset(); // quotient=0
+	//Residue filters, 63*65*11 fits in a word so a single pass reduces n
+	if (!is_square_residue<64>((uint32_t)n._words[0] & 63))
+		return false;
 
-	//Operation are performed in the integers positive values
-	if (remainder.is_negative())
-		remainder.negative();
+	const uint32_t residue = mod_word(n._words.data(), n._words.size(), 63 * 65 * 11);
 
-	if (aux.is_negative())
-		aux.negative();
+	if (!is_square_residue<63>(residue % 63) || !is_square_residue<65>(residue % 65) ||
+			!is_square_residue<11>(residue % 11))
+		return false;
 
-	// First bit index in which the operation will start
-	int index = remainder.findFirstOne() - aux.findFirstOne();
+	Integer r;
+	Integer::sqrtrem(n, r);
 
-	/*Shift aux Integer to make the most significant
-	 *1 bit from both integer to match the same ìndex
-	 */
-	if (index > 0)
-		aux.bitwise_shift_left(index);
+	return r.is_zero();
+}
 
-	int comp;
+Integer Integer::iroot(const Integer & n, size_t k) {
 
-	//Perform division
-	while(index >= 0) {
+	//Preconditions
+	if (k == 0)
+		throw std::invalid_argument("k must be greater than 0");
 
-		quotient.bitwise_shift_left(1);
+	if (n.is_negative() && k % 2 == 0)
+		throw std::invalid_argument("n must be positive or 0 for an even k");
 
-		// Perform deduction whether the dividend is greater than remainder
-		comp = aux.compare(remainder);
+	if (n.is_negative())
+		return -Integer::iroot(-n, k);
 
-		if (comp < 1) {
-				remainder.add(remainder,aux,true);
-				quotient.add(quotient,1);
-		}
+	if (k == 1)
+		return n;
 
-		aux.bitwise_shift_right(1);
-		index--;
-	}
+	if (k == 2)
+		return Integer::sqrt(n);
 
-	//Recover sign to resulting quotient
-	if (sign)
-		quotient.negative();
+	const size_t n_bits = bits_words(n._words.data(), n._words.size());
+
+	//Roots of values below 2^k are 0 or 1
+	if (n_bits <= k)
+		return n.is_zero()? 0 : 1;
+
+	if (n_bits <= 64)
+		return root_native(shifted_bits(n._words.data(), n._words.size(), 0), k);
+
+	//The root has root_bits bits. The root x of the bits of n above k*h gives
+	//the estimate from above (x+1) * 2^h
+	const size_t root_bits = (n_bits + k - 1) / k, h = root_bits / 2;
+	Integer x = (Integer::iroot(n >> (k * h), k) + 1) << h;
+
+	//Newton's iteration decreases from above down to the root
+	while (true) {
+		Integer y = n / Integer::pow(x, k - 1);
+		y += (k - 1) * x;
+		y /= k;
+
+		if (y.compare(x) >= 0)
+			break;
 
-	//Remainder is always positive
-	if (org_sign)
-		remainder.negative();
+		x = std::move(y);
+	}
 
 	//Check postcondition
 	#ifdef DEBUG
-		// original!= 0 => 0 <= remainder < this
-		assert(Integer::abs(remainder).compare(0) >= 0 && Integer::abs(remainder).compare(Integer::abs(d_org)) == -1);
+		assert(Integer::pow(x, k) <= n && Integer::pow(x + 1, k) > n);
+	#endif
 
-		// |original| < |d| => q == 0 and remainder == original
-		assert(!(Integer::abs(original).compare(Integer::abs(d_org)) == -1) ||
-											quotient.is_zero() && remainder.compare(original) == 0);
+	return x;
+}
 
-		// On original = 0 => q = 0 and remainder == 0
-		assert(!original.is_zero() || (quotient.is_zero() && remainder.is_zero()));
+bool Integer::is_perfect_power(const Integer & n) {
+
+	const Integer a = Integer::abs(n);
+
+	//0, 1 and -1 are powers of themselves
+	if (a.compare(1) <= 0)
+		return true;
+
+	//Trailing zeros of a, which the exponent must divide
+	size_t i = 0;
+
+	while (a._words[i] == 0)
+		i++;
+
+	const size_t zeros = i * N_BITS_PER_WORD + std::countr_zero((uint32_t)a._words[i]);
+	const size_t n_bits = bits_words(a._words.data(), a._words.size());
+
+	//a = 2^zeros * odd is a p-th power when p divides zeros and odd is a p-th
+	//power, so the roots are taken on odd
+	const Integer odd = a >> zeros;
+	const size_t odd_bits = n_bits - zeros;
+	const uint64_t odd_low = shifted_bits(odd._words.data(), odd._words.size(), 0);
+	const uint32_t odd_residue = mod_word(odd._words.data(), odd._words.size(), 0x7fffffff);
 
-		// On original = d => q = 1 and remainder = 0
-		assert(!(original.compare(d_org) == 0) || (quotient.compare(1) == 0 && remainder.is_zero()));
+	//Composite exponents are powers of a prime exponent, sieved up to n_bits
+	std::vector<bool> composite(n_bits + 1, false);
 
-		// On d = 1 => original = q and remainder = 0
-		assert(!(d.compare(1) == 0) || (original.compare(quotient) == 0 && remainder.is_zero()));
-	#endif
+	for (size_t p = 2; p * p <= n_bits; p++)
+		if (!composite[p])
+			for (size_t j = p * p; j <= n_bits; j += p)
+				composite[j] = true;
 
-}
+	//Even exponents do not give negative values
+	for (size_t p = n.is_negative()? 3 : 2; p <= n_bits; p++) {
 
-void Integer::power(const Integer & exp) {
+		if (composite[p] || zeros % p != 0)
+			continue;
 
-	// Keep original dividend value for postcondition check
-	#ifdef DEBUG
-		Integer original(*this);
-	#endif
+		if (p == 2) {
+			if (Integer::is_perfect_square(odd))
+				return true;
 
-	//Precondition
-	if (exp.is_negative())
-		throw std::invalid_argument("exp must be positive or 0");
+			continue;
+		}
 
-	Integer result(1);
-	Integer aux(*this);
-	Integer exp_aux(exp);
+		//Roots up to 64 bits are given by the 64 less significant bits of odd, so
+		//only their length and their residue modulo 2^31-1 are checked before
+		//their power is compared
+		if (p * 64 >= odd_bits) {
+			const uint64_t r = root_2adic(odd_low, p);
 
-	while (!exp_aux.is_zero()) {
-		/* this.pow(exp) can be expressed as
-		 * this.pow(exp) = this.pow(exp/2) * this.pow(exp/2) when exp is even
-		 * and this.pow(exp) = this.pow(exp/2) * this.pow(exp/2) * this when odd.
-		 * In this way, recursive computation is applied
-		*/
+			if ((size_t)std::bit_width(r) == (odd_bits + p - 1) / p &&
+					pow_mod(r, p, 0x7fffffff) == odd_residue && Integer::pow(Integer(r), p) == odd)
+				return true;
 
-		if (!exp_aux.is_even()) {
-			result *= aux; // On odd exp
+			continue;
 		}
 
-		aux *= aux;
+		if (!is_power_residue(odd._words.data(), odd._words.size(), p))
+			continue;
 
-		exp_aux.bitwise_shift_right(1); // exp_aux = exp_aux / 2
+		if (Integer::pow(Integer::iroot(odd, p), p) == odd)
+			return true;
 	}
 
-	//The result is copied on the current integer in a faster way
-	this->_words.swap(result._words);
+	return false;
+}
 
-	//Check postcondition
-	#ifdef DEBUG
-		// On exp = 0 => this = 1
-		assert(!exp.is_zero() || this->compare(1) == 0);
+Integer Integer::powmod(const Integer & base, const Integer & exp, const Integer & mod) {
 
-		// On original = 1 => this = 1
-		assert(!original.compare(1) == 0 || this->compare(1) == 0);
+	//Preconditions
+	if (exp.is_negative())
+		throw std::invalid_argument("exp must be positive or 0");
 
-		// On original = 0 and exp != 0 => this = 0
-		assert(!(original.compare(0) == 0 && !exp.is_zero()) || this->compare(0) == 0);
+	if (mod.is_zero())
+		throw zero_division_error();
 
-		// On original > 1 and exp > 1 => this > original
-		assert(!(original.compare(1) == 1 && exp.compare(1) == 1) ||
-																this->compare(original) == 1);
+	if (mod.is_negative())
+		throw std::invalid_argument("mod must be positive");
 
-		// On original < 0 and exp.is_even() => this > 0 and this > -original
-		assert(!(original.compare(0) == -1 && exp.compare(1) == 1 && exp.is_even()) ||
-													(this->compare(0) == 1 && this->compare(-original) == 1));
+	//Every value is 0 modulo 1
+	if (mod.compare(1) == 0)
+		return Integer();
 
-		// On original < 0 and ¬exp.is_even() => this < 0 and this < original
-		assert(!(original.compare(0) == -1 && exp.compare(1) == 1 && !exp.is_even()) ||
-													(this->compare(0) == -1 && this->compare(original) == -1));
-	#endif
+	if (!mod.is_even())
+		return MontgomeryContext(mod).power(base, exp);
 
-	return;
+	return BarrettContext(mod).power(base, exp);
 }
 
 void Integer::bitwise_not() {
 
-	//Perform bitwise NOT on each block.
-	for (size_t i = 0; i < _words.size() - 1; i++)
-		_words[i] = ((~_words[i]) & 0x7fffffff);
+	/*~x = -x - 1, so the absolute value is increased by 1 on positive values
+	 *and decreased by 1 on negative ones, and the sign is flipped */
+	const int32_t one = 1;
+
+	if (this->_negative)
+		sub_words(this->_words.data(), this->_words.data(), this->_words.size(), &one, 1);
+	else if (add_words(this->_words.data(), this->_words.data(), this->_words.size(), &one, 1) != 0) {
+		this->resize(this->_words.size() + 1);
+		this->_words.back() = 1;
+	}
 
-	this->_words.back() = ~this->_words.back();
+	this->_negative = !this->_negative;
 
 	this->fix(); // Remove redundant words
 
 	//Check postcondition
 	#ifdef DEBUG
-		assert(!(this->_words.size() > 1) ||
-									(this->_words.back() != 0 && this->_words.back() != -1));
+		assert(!(this->_words.size() > 1) || this->_words.back() != 0);
 
-		for (size_t i = 0; i < this->_words.size()-1; i++)
+		for (size_t i = 0; i < this->_words.size(); i++)
 			assert((this->_words[i] & 0x80000000) == 0);
 	#endif
 }
 
 void Integer::bitwise_and(const Integer & n) {
 
-	/*Resize current Integer to the smallest size of blocks as the
-	 * non-existing blocks of smaller Integer are supposed to be zero
-	 * (bitwise AND with any other block will result zero)*/
-	const size_t size = MIN(this->_words.size(), n._words.size());
-
-	if (n._words.size() < this->_words.size() && !n.is_negative())
-		/* On performing bitwise AND between the additional words from this and the
-		 * non-existing words from n (considered having 0 value), all the words from
-		 * this portion results 0 and it can be removed, so this is resized to n
-		 * size whether n is positive. On n being negative, the additional words
-		 * will be bitwised AND with 1's bits for the heading non-existing block of
-		 * n, so the additional words remains with the same value in the resulting
-		 * Integer.
-		 */
-		this->resize( n._words.size() );
-	else if (n._words.size() > this->_words.size() && this->is_negative()) {
-		/* On considering additional words on n being bitwised AND with 0's bits
-		 * (for the non-existing words from this), the additional words can be discarded
-		 * whether this is positive. On this being negative, the additional words on
-		 * n are considered to be bitwised AND with 1's bits, so the additional
-		 * words on n are appended to the resulting Integer.
-		 */
-		this->resize(n._words.size());
-
-		for (size_t i = size; i < n._words.size(); i++)
-			this->_words[i] = n._words[i];
-	}
-
-	//Perform bitwise AND word by word
-	for (size_t i=0; i < size; i++)
-		this->_words[i] &= n._words[i];
+	const size_t n1 = this->_words.size(), n2 = n._words.size();
+	const bool sign = this->_negative && n._negative;
+
+	/*Words over a positive operand are zero and its AND with any other word
+	 * results zero, while words over a negative operand have all the bits to 1,
+	 * so the words of the other operand are kept */
+	size_t size = MAX(n1, n2);
+
+	if (!this->_negative)
+		size = MIN(size, n1);
+
+	if (!n._negative)
+		size = MIN(size, n2);
+
+	this->resize(size);
+
+	//Perform bitwise AND word by word on the two's complement representations
+	uint32_t carry1 = 1, carry2 = 1;
+
+	for (size_t i = 0; i < size; i++) {
+		const int32_t w1 = twos_complement_word(this->_words.data(), n1, i, this->_negative, carry1);
+		const int32_t w2 = twos_complement_word(n._words.data(), n2, i, n._negative, carry2);
+
+		this->_words[i] = w1 & w2;
+	}
+
+	//Negative results are turned back into their absolute value
+	this->_negative = false;
+
+	if (sign)
+		this->complement_words();
 
 	this->fix(); //Remove redundant words at begining
 }
 
 void Integer::bitwise_or(const Integer & n) {
 
-	/*The exceeding blocks of longest integer do not require to be procesed as the
-	* non-existing blocks of the smallest integer does not compute in the final
-	*	result*/
-	size_t size = MIN(this->_words.size(), n._words.size());
-	bool sign = this->is_negative() | n.is_negative();
-	size_t i;
+	const size_t n1 = this->_words.size(), n2 = n._words.size();
+	const bool sign = this->_negative || n._negative;
 
-	//Perform bitwise OR block by block
-	for (i = 0; i < size; i++)
-		this->_words[i] |= (n._words[i] & 0x7fffffff);
+	/*Words over a negative operand have all the bits to 1 and its OR with any
+	 * other word results all the bits to 1, which are redundant on a negative
+	 * result, while words over a positive operand are zero, so the words of
+	 * the other operand are kept */
+	size_t size = MAX(n1, n2);
 
-	/* If n is longer and this is positive, the additional words of n are directly
-	 *	removed as the non-existing words from n are considered to have 0 value,
-	 *	otherwise, if n is shorter and negative, the non-existing blocks are considered
-	 *	to have all bits at 1 and the exceeding words from this are redundant.
-	*/
-	if (this->_words.size() < n._words.size() && !this->is_negative() ||
-						(this->_words.size() > n._words.size() && n.is_negative())) {
-		this->resize(n._words.size());
+	if (this->_negative)
+		size = MIN(size, n1);
+
+	if (n._negative)
+		size = MIN(size, n2);
+
+	this->resize(size);
 
-		//Copy the rest of blocks whether n is longer
-		for (;i < n._words.size(); i++)
-			this->_words[i] = n._words[i];
+	//Perform bitwise OR word by word on the two's complement representations
+	uint32_t carry1 = 1, carry2 = 1;
+
+	for (size_t i = 0; i < size; i++) {
+		const int32_t w1 = twos_complement_word(this->_words.data(), n1, i, this->_negative, carry1);
+		const int32_t w2 = twos_complement_word(n._words.data(), n2, i, n._negative, carry2);
+
+		this->_words[i] = w1 | w2;
 	}
 
-	// bitwise sign bit
+	//Negative results are turned back into their absolute value
+	this->_negative = false;
+
 	if (sign)
-		this->_words.back() |= 0x80000000;
+		this->complement_words();
 
 	this->fix(); // Remove redundant words if still needed
 
 	//Check postcondition
 	#ifdef DEBUG
-		assert(!(this->_words.size() > 1) ||
-									(this->_words.back() != 0 && this->_words.back() != -1));
+		assert(!(this->_words.size() > 1) || this->_words.back() != 0);
 
-		for (size_t i = 0; i < this->_words.size()-1; i++)
+		for (size_t i = 0; i < this->_words.size(); i++)
 			assert((this->_words[i] & 0x80000000) == 0);
 	#endif
 
@@ -572,60 +3760,47 @@ void Integer::bitwise_or(const Integer & n) {
 
 void Integer::bitwise_shift_left(size_t d) {
 
-	size_t f_shift = d / 31;
-	size_t p_shift = d % 31;
-	int64_t aux;
+	//The absolute value is shifted, the sign is kept
+	if (this->is_zero())
+		return;
+
+	const size_t f_shift = d / 31;
+	const size_t p_shift = d % 31;
 
 	//Partial block shifting is carried out
-	if (p_shift>0) {
+	if (p_shift > 0) {
 
-		int i = _words.size()-1;
+		uint32_t carry = 0;
 
-		//Shift the most significant block
-		aux = _words.back();
-		aux <<= p_shift;
-		_words[i] = aux & (int32_t)0x7fffffff;
-		aux >>= 31;
+		for (size_t i = 0; i < this->_words.size(); i++) {
+			const uint64_t aux = ((uint64_t)this->_words[i] << p_shift) | carry;
 
-		//Store the shifted block if is not redundant
-		if (aux != 0 && aux != -1) {
-			this -> resize(this->_words.size() + 1);
-			this -> _words.back() = (aux & (int32_t)0x7fffffff);
+			//Split the shifted word into the 31 bits kept and the bits carried
+			this->_words[i] = (int32_t)(aux & 0x7fffffff);
+			carry = (uint32_t)(aux >> 31);
 		}
 
-		if (aux<0)
-			this -> _words.back() |= 0x80000000;
-
-		i--;
-
-		//Shift the rest of blocks
-		for (;i>=0; i--) {
-
-			aux = _words[i];
-			aux <<= p_shift;
-
-			//Split the shifted integer into two 32 bits integer excluding the sign bit
-			_words[i] = aux & (int32_t)0x7fffffff;
-			aux >>= 31;
-
-			_words[i + 1] += aux & (int32_t)0x7fffffff;
+		//Store the carried bits if they are not redundant
+		if (carry != 0) {
+			this->resize(this->_words.size() + 1);
+			this->_words.back() = (int32_t)carry;
 		}
-
 	}
 
 	//Add extra required zero blocks at last
-	if (f_shift > 0 && _words.back() != 0) {
-		_words.insert(_words.begin(), f_shift, 0);
-	}
+	if (f_shift > 0) {
+		const size_t n = this->_words.size();
 
-	this->fix(); // Remove redundant words
+		this->resize(n + f_shift);
+		std::move_backward(this->_words.begin(), this->_words.begin() + n, this->_words.end());
+		std::fill(this->_words.begin(), this->_words.begin() + f_shift, 0);
+	}
 
 	//Check postcondition
 	#ifdef DEBUG
-	assert(!(this->_words.size() > 1) || (this->_words.back() != 0 &&
-																									this->_words.back() != -1));
+		assert(!(this->_words.size() > 1) || this->_words.back() != 0);
 
-		for (size_t i = 0; i < this->_words.size()-1; i++)
+		for (size_t i = 0; i < this->_words.size(); i++)
 			assert((this->_words[i] & 0x80000000) == 0);
 	#endif
 
@@ -634,45 +3809,51 @@ void Integer::bitwise_shift_left(size_t d) {
 void Integer::bitwise_shift_right(size_t d) {
 
 	//Compute the full blocks to be removed and the partial shift on every block
-	size_t f_shift = d /31;
-	size_t p_shift = d % 31;
-	int64_t aux;
+	const size_t f_shift = d / 31;
+	const size_t p_shift = d % 31;
 
-	//Remove full blocks shifted to the right
-	if (f_shift>0) {
-		_words.erase(_words.begin(),_words.begin() + MIN(f_shift,_words.size()));
+	/*Negative values are rounded towards minus infinity as the two's
+	 *complement arithmetic shift does, so |x| is increased by 1 when any 1 bit
+	 *is shifted out */
+	bool round = false;
+
+	if (this->_negative) {
+		for (size_t i = 0; i < MIN(f_shift, this->_words.size()) && !round; i++)
+			round = this->_words[i] != 0;
+
+		if (f_shift < this->_words.size())
+			round = round || (this->_words[f_shift] & ((1 << p_shift) - 1)) != 0;
 	}
 
+	//Remove full blocks shifted to the right
+	if (f_shift >= this->_words.size())
+		this->_words.assign(1, 0);
+	else if (f_shift > 0)
+		this->_words.erase(this->_words.begin(), this->_words.begin() + f_shift);
+
 	//Perform partial shifting on each block
-	if (p_shift>0 && _words.empty()==false) {
+	if (p_shift > 0) {
 
-		//Shift in the first block
-		if (_words.size() == 1) {
-			aux = _words[0];
-			aux >>= p_shift;
-			_words[0] = aux;
-		}
-		else {
-			aux = _words[0];
-			aux >>= p_shift;
-			_words[0] = aux & 0x7fffffff;
-		}
+		const size_t n = this->_words.size();
 
-		//Shift in the rest of block
-		for (size_t i=1;i<_words.size();i++) {
-				aux = _words[i];
-				aux <<= (31 - p_shift);
+		for (size_t i = 0; i < n; i++) {
+			uint64_t aux = (uint32_t)this->_words[i] >> p_shift;
 
-				//Split 64-bit auxiliar block shifted into two 32-bits blocks integers
-				_words[i-1] += (aux & (int32_t)0x7fffffff);
-				aux>>=31;
-				_words[i] = aux & (int32_t)0x7fffffff;
+			//Bits of the next word are placed at the top of the current one
+			if (i + 1 < n)
+				aux |= ((uint64_t)this->_words[i + 1] << (31 - p_shift)) & 0x7fffffff;
+
+			this->_words[i] = (int32_t)aux;
 		}
+	}
 
-		//Add negative sign to the most signicant block if required
-		if (aux<0)
-			_words.back() |= 0x80000000;
+	if (round) {
+		const int32_t one = 1;
 
+		if (add_words(this->_words.data(), this->_words.data(), this->_words.size(), &one, 1) != 0) {
+			this->resize(this->_words.size() + 1);
+			this->_words.back() = 1;
+		}
 	}
 
 	fix(); //Remove redundant blooks
@@ -682,97 +3863,134 @@ void Integer::bitwise_shift_right(size_t d) {
 int Integer::compare(const Integer & n) const {
 
 	//Resolve trivial cases
-	if (this->_words.size() > n._words.size())
-			return this->is_negative()? -1: 1;
-	else if (this->_words.size() < n._words.size())
-			return n.is_negative()? 1: -1;
-	else if (this->is_negative() && !n.is_negative())
-			return -1;
-	else if (!this->is_negative() && n.is_negative())
-			return 1;
-	else {
-			/*Both integers have same number of words and same sign and
-			 comparison can be performed word by word */
-			for (int i = this->_words.size() - 1; i>=0; i--) {
-
-				if (this->_words[i] > n._words[i])
-					return 1;
-				else if (this->_words[i] < n._words[i])
-					return -1;
-			}
+	if (this->_negative != n._negative)
+		return this->_negative? -1 : 1;
 
-			//All the words are equal so Integers have the same value
-			return 0;
-	}
+	//Both integers have the same sign, so their absolute values are compared
+	int comp;
+
+	if (this->_words.size() != n._words.size())
+		comp = this->_words.size() > n._words.size()? 1 : -1;
+	else
+		comp = compare_words(this->_words.data(), this->_words.size(),
+													n._words.data(), n._words.size());
 
+	return this->_negative? -comp : comp;
 }
 
-void Integer::resize(size_t n) {
+int Integer::compare_scalar(unsigned __int128 m, bool negative) const {
 
-		//Precondition
-		#ifdef DEBUG
-			assert(n > 0);
-		#endif
+	//Resolve trivial cases
+	if (this->_negative != negative)
+		return this->_negative? -1 : 1;
 
-		size_t org_size = this -> _words.size();
-		int32_t sign = !_words.empty()? (_words.back() & 0x80000000) : 0;
+	//Words of the scalar absolute value, with no redundant words
+	int32_t words[SCALAR_MAX_WORDS]{};
+	size_t n_words = 0;
 
-		if (sign) {
-			_words.back() &= 0x7fffffff;
+	for (; m != 0; m >>= 31)
+		words[n_words++] = (int32_t)(m & 0x7fffffff);
 
-			// Determines whether the sign should be kept when size is decreased
-			if (org_size > n) {
+	const int comp = compare_words(this->_words.data(), this->_words.size(), words, n_words);
 
-				for (size_t i = n; i < org_size; i++) {
-					if (this->_words[i] != 0x7fffffff) {
-						sign = (int32_t)0;
-						break;
-					}
-				}
+	return negative? -comp : comp;
+}
 
-			}
+int Integer::compare_string(std::string_view n) const {
 
-		}
+	const bool negative = !n.empty() && n[0] == '-';
+	size_t first = negative? 1 : 0;
+
+	for (size_t i = first; i < n.length(); i++)
+		if (n[i] < '0' || n[i] > '9') {
+			// Not valid character is found
+			std::string message("Input string ");
+			message += '"';
+			message += n;
+			message += '"';
+			message += " does not contain valid digits";
 
-		_words.resize(n, sign? INT32_MAX: 0);
+			throw std::invalid_argument(message);
+		}
 
-		//Place the bit sign into the new most significant block
-		if (sign)
-				_words.back() |= sign;
+	while (first < n.length() && n[first] == '0')
+		first++;
 
-		//Postcondition
-		#ifdef DEBUG
-			assert(_words.size() == n);
-			for(size_t i = 0; i < _words.size() - 1; i++)
-				assert(_words[i] >= 0);
+	const size_t n_digits = n.length() - first;
 
-			assert(!sign || _words.back() <= 0);
-		#endif
-}
+	//Values up to 38 digits fit on 128 bits
+	if (n_digits <= 38) {
+		unsigned __int128 m = 0;
 
-void Integer::string_to_integer(const std::string & n) {
+		for (size_t i = first; i < n.length(); i++)
+			m = m * 10 + (n[i] - '0');
 
-	this->reset();
+		return this->compare_scalar(m, negative && m != 0);
+	}
 
-	Integer pow_ten(1); //powers of 10 auxiliar integer
-	Integer aux;
+	//The string value is out of the 128 bits range, so it is not zero
+	if (this->is_negative() != negative || this->is_zero())
+		return this->is_negative() || (this->is_zero() && !negative)? -1 : 1;
 
-	for (int i = n.length() - 1; i>=0; i--) {
+	//Number of bits of the absolute value of the current Integer bounds its number of digits
+	const size_t n_bits = this->findFirstOne() + 1;
 
-		if (n[i] >= '0' && n[i] <= '9') {
+	const double log10_2 = 0.30102999566398120;
+	const size_t min_digits = (size_t)((n_bits > 1? n_bits - 1 : 0) * log10_2) + 1;
+	const size_t max_digits = (size_t)((n_bits + 1) * log10_2) + 1;
 
-			//Read integer decimal digit by decimal digit
-			aux.multiply(pow_ten, n[i] - '0');
-			this->add(*this, aux);
+	//A margin of one digit covers floating point rounding
+	int magnitude = 0;
 
-			pow_ten.multiply(pow_ten,10);
+	if (n_digits + 1 < min_digits)
+		magnitude = 1;
+	else if (n_digits > max_digits + 1)
+		magnitude = -1;
+	else if (!this->_modified) {
+		//The decimal representation was already computed
+		const std::string_view cache(this->_str_fmt_cache);
+		const std::string_view digits = cache.substr(negative? 1 : 0);
 
+		if (digits.length() != n_digits)
+			magnitude = digits.length() > n_digits? 1 : -1;
+		else {
+			const int c = digits.compare(n.substr(first));
+			magnitude = c > 0? 1 : (c < 0? -1 : 0);
 		}
-		else if (i == 0 && n[i]=='-') {
-			//Read negative sign
-			this->negative();
+	}
+	else
+		return this->compare(Integer(std::string(n)));
+
+	return negative? -magnitude : magnitude;
+}
+
+void Integer::resize(size_t n) {
+
+		//Precondition
+		#ifdef DEBUG
+			assert(n > 0);
+		#endif
+
+		//Capacity grows geometrically, so growing word by word is amortized O(1).
+		//Grown capacities are clamped to the max size before being converted
+		if (n > _words.capacity()) {
+			const double grown = _words.capacity() * Integer::_growth_factor;
+			const size_t max_size = std::vector<int32_t>().max_size();
+			const size_t capacity = grown < (double)max_size? (size_t)grown : max_size;
+
+			_words.reserve(MAX(n, capacity));
 		}
-		else {
+
+		//Words hold the absolute value, so new words are zero
+		_words.resize(n, 0);
+}
+
+void Integer::string_to_integer(const std::string & n) {
+
+	const bool negative = !n.empty() && n[0] == '-';
+
+	for (size_t i = negative? 1 : 0; i < n.length(); i++)
+		if (n[i] < '0' || n[i] > '9') {
 			// Not valid character is found
 			std::string message("Input string ");
 			message += '"';
@@ -782,8 +4000,29 @@ void Integer::string_to_integer(const std::string & n) {
 
 			throw std::invalid_argument(message);
 		}
+
+	/*Digits are read in chunks of 9 (10^9 < 2^31) and accumulated into a
+	 *words buffer, normalized once at the end */
+	std::vector<int32_t> words(1, 0);
+	words.reserve((n.length() * 10) / (3 * N_BITS_PER_WORD) + 2);
+
+	for (size_t i = negative? 1 : 0; i < n.length(); ) {
+		const size_t length = MIN((size_t)9, n.length() - i);
+		uint32_t chunk = 0, scale = 1;
+
+		for (size_t t = 0; t < length; t++, i++) {
+			chunk = chunk * 10 + (n[i] - '0');
+			scale *= 10;
+		}
+
+		const uint32_t carry = mul_add_word(words.data(), words.size(), scale, chunk);
+
+		if (carry != 0)
+			words.push_back((int32_t)carry);
 	}
 
+	this->assign_words(words, negative);
+
 	//Postcondición
 	#ifdef DEBUG
 		assert(this->getString() == n || this->is_zero());
@@ -794,35 +4033,34 @@ void Integer::string_to_integer(const std::string & n) {
 
 void Integer::integer_to_string(std::string & s) const{
 
-	std::string string_aux;
 	s.clear();
 
-	Integer aux(*this);
-	Integer r;
-	Integer ten(10);
-
-	//Work with the positive representation of integer
 	if (this->is_negative())
-		aux.negative();
+		s += '-';
 
-	//Retrieve every digit by succesive divisions by 10
-	aux.divide(ten, aux, r);
+	/*Chunks of 9 digits are retrieved by successive divisions by 10^9 on a
+	 *copy of the words, whose number of significant words is tracked */
+	std::vector<int32_t> words(this->_words);
+	std::vector<uint32_t> chunks;
+	size_t n = words.size();
 
-	while (aux.is_zero() == false) {
-		string_aux += (int)r + '0';
-		aux.divide(ten,aux,r);
-	}
+	do {
+		chunks.push_back(div_word(words.data(), n, 1000000000));
 
-	// Integer value is 0
-	if (string_aux.empty() || !r.is_zero())
-		string_aux += (int)r + '0';
+		while (n > 1 && words[n - 1] == 0)
+			n--;
 
-	if (this->is_negative())
-		string_aux += '-';
+	} while (n > 1 || words[0] != 0);
+
+	//Most significant chunk is written without leading zeros
+	s += std::to_string(chunks.back());
 
-	//Postprocess to obtain the actual decimal representation of the Integer.
-	for (int i = string_aux.length()-1; i>=0; i--)
-		s.push_back(string_aux[i]);
+	for (size_t i = chunks.size() - 1; i > 0; i--) {
+		const std::string digits(std::to_string(chunks[i - 1]));
+
+		s.append(9 - digits.length(), '0');
+		s += digits;
+	}
 
 }
 
@@ -837,15 +4075,22 @@ const std::string Integer::getBinary(char delimit) const {
 		else
 			result += "0|";
 
+		//Two's complement words of the value
+		std::vector<int32_t> words(_words.size());
+		uint32_t carry = 1;
+
+		for (size_t i = 0; i < words.size(); i++)
+			words[i] = twos_complement_word(_words.data(), _words.size(), i, _negative, carry);
+
 		//Write bits of each blocks
-		for (int i = _words.size() - 1; i >= 0; i--) {
+		for (int i = words.size() - 1; i >= 0; i--) {
 
 				aux = 0x40000000; //32-bit integer having bit 1 at index 31.
 
 				for (int t = 30; t >= 0; t--) {
 
 					//Write rest of bits
-					if ((_words[i] & aux) > 0)
+					if ((words[i] & aux) > 0)
 						result += '1';
 					else
 						result += '0';
@@ -864,11 +4109,6 @@ const std::string Integer::getBinary(char delimit) const {
 
 size_t Integer::findFirstOne() const {
 
-		/*If negative, the most significant bit 1 is placed on the 31th bit of
-		 *most significant block*/
-		if (is_negative())
-			return _words.size() * N_BITS_PER_WORD;
-
 		int32_t aux = _words.back();
 		size_t index_aux = 0;
 
@@ -906,6 +4146,7 @@ void Integer::set_random_value(size_t n_bits_max) {
 	}
 
 	this->_words.back() &= first_word_mask;
+	this->_negative = false;
 	this->fix(); // Remove redundant word
 
 	// Check postcondition
@@ -918,6 +4159,67 @@ void Integer::set_random_value(size_t n_bits_max) {
 	#endif
 }
 
+void Integer::set_thresholds(const Thresholds & thresholds) {
+
+	if (thresholds.karatsuba_multiply < 2)
+		throw std::invalid_argument("karatsuba_multiply threshold must be 2 or greater");
+
+	if (thresholds.ntt_multiply <= thresholds.karatsuba_multiply)
+		throw std::invalid_argument("ntt_multiply threshold must be greater than karatsuba_multiply");
+
+	if (thresholds.ntt_block < 2 || (thresholds.ntt_block & (thresholds.ntt_block - 1)) != 0)
+		throw std::invalid_argument("ntt_block threshold must be a power of 2");
+
+	if (thresholds.short_product < 4)
+		throw std::invalid_argument("short_product threshold must be 4 or greater");
+
+	if (thresholds.hgcd < 4)
+		throw std::invalid_argument("hgcd threshold must be 4 or greater");
+
+	Integer::_thresholds = thresholds;
+}
+
+void Integer::load_thresholds(const std::string & filename) {
+
+	std::ifstream file(filename);
+
+	if (!file)
+		throw std::runtime_error("Cannot read thresholds file " + filename);
+
+	Thresholds thresholds(Integer::_thresholds);
+	std::string line, name;
+	long long value;
+
+	while (std::getline(file, line)) {
+
+		std::istringstream fields(line);
+
+		//Skip empty lines and comments
+		if (!(fields >> name) || name[0] == '#')
+			continue;
+
+		if (!(fields >> value) || value < 0)
+			throw std::invalid_argument("Non-valid value for threshold " + name);
+
+		if (name == "karatsuba_multiply")
+			thresholds.karatsuba_multiply = value;
+		else if (name == "ntt_multiply")
+			thresholds.ntt_multiply = value;
+		else if (name == "ntt_parallel")
+			thresholds.ntt_parallel = value;
+		else if (name == "ntt_block")
+			thresholds.ntt_block = value;
+		else if (name == "short_product")
+			thresholds.short_product = value;
+		else if (name == "hgcd")
+			thresholds.hgcd = value;
+		else
+			throw std::invalid_argument("Unknown threshold " + name);
+	}
+
+	Integer::set_thresholds(thresholds);
+}
+
 std::istream & operator>>(std::istream & stream, Integer & n) {
 
 	Integer::Stream_read_state state = Integer::SKIP;
@@ -957,25 +4259,25 @@ std::istream & operator>>(std::istream & stream, Integer & n) {
 
 long long int Integer::getInt() const {
 
-	//Check precondition
-	if (this->_words.size() * sizeof(int32_t) >= sizeof(long long int)) {
+	//Check precondition. Absolute value takes 3 words as max
+	if (this->_words.size() > 3) {
 		throw integer_conversion_error();
 	}
 
-	long long int ret(0LL);
-	long long int aux;
-
-	const size_t length = this->_words.size();
+	unsigned __int128 m = 0;
 
-	// Writes the block into a long long int type until max capacity is reachen
-	for (size_t i=0; i < length; i++) {
+	// Writes the blocks of the absolute value
+	for (size_t i = this->_words.size(); i > 0; i--)
+		m = (m << 31) | (uint32_t)this->_words[i - 1];
 
-		aux = this->_words[i];
-		aux <<= (31*i);
-
-		ret += aux;
+	//-2^63 is the only value whose absolute value exceeds LLONG_MAX
+	if (m > (unsigned __int128)std::numeric_limits<long long int>::max() + this->_negative) {
+		throw integer_conversion_error();
 	}
 
+	const long long int ret = this->_negative? (long long int)(0ULL - (unsigned long long)m) :
+																							(long long int)m;
+
 	//Check postcondition
 	#ifdef DEBUG
 		assert(this->compare(ret) == 0);
@@ -983,3 +4285,174 @@ long long int Integer::getInt() const {
 
 	return ret;
 }
+
+/////	Modular Integer	/////
+
+ModInteger::ModInteger(const Integer & mod) {
+
+	if (mod.compare(2) < 0)
+		throw std::invalid_argument("Modulus must be greater than 1");
+
+	if (mod.is_even())
+		this->_barrett = std::make_shared<const Integer::BarrettContext>(mod);
+	else
+		this->_montgomery = std::make_shared<const Integer::MontgomeryContext>(mod);
+
+	this->_words.assign(mod._words.size(), 0);
+}
+
+ModInteger::ModInteger(const Integer & value, const Integer & mod): ModInteger(mod) {
+	this->load(value);
+}
+
+ModInteger::ModInteger(const Integer & value, const ModInteger & other):
+											_montgomery(other._montgomery), _barrett(other._barrett) {
+	this->load(value);
+}
+
+const int32_t * ModInteger::modulus_words() const {
+	return this->_montgomery? this->_montgomery->_m.data() : this->_barrett->_m.data();
+}
+
+void ModInteger::load(const Integer & value) {
+
+	if (this->_montgomery) {
+		const Integer::MontgomeryContext & context = *this->_montgomery;
+		const size_t n = context._m.size();
+
+		this->_words.resize(n);
+		context.load(this->_words.data(), value);
+		montgomery_mul(this->_words.data(), this->_words.data(), context._r2.data(), context._m.data(),
+										n, context._m_inv, thread_workspace(montgomery_workspace(n)));
+	}
+	else {
+		this->_words.resize(this->_barrett->_n);
+		this->_barrett->load(this->_words.data(), value);
+	}
+}
+
+void ModInteger::check_modulus(const ModInteger & n) const {
+
+	//Contexts are compared first, so moduli are only compared on different contexts
+	if (this->_montgomery == n._montgomery && this->_barrett == n._barrett)
+		return;
+
+	if (this->_words.size() != n._words.size() || (bool)this->_montgomery != (bool)n._montgomery ||
+			compare_words(this->modulus_words(), this->_words.size(), n.modulus_words(), n._words.size()) != 0)
+		throw std::invalid_argument("ModInteger operands must have the same modulus");
+}
+
+Integer ModInteger::value() const {
+
+	std::vector<int32_t> words(this->_words);
+
+	//Value is taken out of Montgomery form: w/R = w*1/R
+	if (this->_montgomery) {
+		const Integer::MontgomeryContext & context = *this->_montgomery;
+		const size_t n = words.size();
+		std::vector<int32_t> one(n, 0);
+
+		one[0] = 1;
+		montgomery_mul(words.data(), words.data(), one.data(), context._m.data(), n,
+										context._m_inv, thread_workspace(montgomery_workspace(n)));
+	}
+
+	Integer ret;
+	ret.assign_words(words);
+
+	return ret;
+}
+
+Integer ModInteger::modulus() const {
+	return this->_montgomery? this->_montgomery->modulus() : this->_barrett->modulus();
+}
+
+ModInteger & ModInteger::operator+=(const ModInteger & n) {
+
+	this->check_modulus(n);
+
+	const size_t size = this->_words.size();
+	const int32_t * m = this->modulus_words();
+	int32_t * w = this->_words.data();
+
+	//a + b < 2m, so a single subtraction reduces it. Montgomery form is linear
+	const int32_t carry = add_words(w, w, size, n._words.data(), size);
+
+	if (carry != 0 || compare_words(w, size, m, size) >= 0)
+		sub_words(w, w, size, m, size);
+
+	return *this;
+}
+
+ModInteger & ModInteger::operator-=(const ModInteger & n) {
+
+	this->check_modulus(n);
+
+	const size_t size = this->_words.size();
+	int32_t * w = this->_words.data();
+
+	if (sub_words(w, w, size, n._words.data(), size) != 0)
+		add_words(w, w, size, this->modulus_words(), size);
+
+	return *this;
+}
+
+ModInteger & ModInteger::operator*=(const ModInteger & n) {
+
+	this->check_modulus(n);
+
+	const size_t size = this->_words.size();
+	int32_t * w = this->_words.data();
+
+	if (this->_montgomery) {
+		const Integer::MontgomeryContext & context = *this->_montgomery;
+
+		montgomery_mul(w, w, n._words.data(), context._m.data(), size, context._m_inv,
+										thread_workspace(montgomery_workspace(size)));
+	}
+	else
+		this->_barrett->mulmod_words(w, w, n._words.data(),
+																	thread_workspace(this->_barrett->workspace()));
+
+	return *this;
+}
+
+ModInteger ModInteger::operator-() const {
+
+	ModInteger ret(*this);
+	const size_t size = this->_words.size();
+
+	if (std::any_of(this->_words.begin(), this->_words.end(), [](int32_t w) {return w != 0;}))
+		sub_words(ret._words.data(), this->modulus_words(), size, this->_words.data(), size);
+
+	return ret;
+}
+
+bool ModInteger::operator==(const ModInteger & n) const {
+
+	this->check_modulus(n);
+
+	//Values are kept reduced, so they are equal when their words are
+	return this->_words == n._words;
+}
+
+ModInteger ModInteger::pow(const Integer & exp) const {
+
+	//Precondition
+	if (exp.is_negative())
+		throw std::invalid_argument("exp must be positive or 0");
+
+	ModInteger ret(*this);
+
+	if (this->_montgomery)
+		this->_montgomery->power_words(ret._words.data(), this->_words.data(), exp);
+	else
+		this->_barrett->power_words(ret._words.data(), this->_words.data(), exp);
+
+	return ret;
+}
+
+ModInteger ModInteger::inverse() const {
+
+	return ModInteger(Integer::invert(this->value(), this->modulus()), *this);
+}
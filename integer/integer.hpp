@@ -3,38 +3,244 @@
 
 #include <cstdint>
 #include <vector>
+#include <memory>
 #include <string>
 #include <random>
 #include <cassert>
 #include <exception>
 #include <stdexcept>
+#include <span>
+#include <string_view>
+#include <compare>
+#include <cmath>
 
 #define DEFAULT_MAX_N_BITS 1000	// <- Default max num of bits set for random generation
 #define N_BITS_PER_WORD 31			// <- Number of usable bits per word
+#define DEFAULT_GROWTH_FACTOR 2.0	// <- Default factor applied to the words capacity when it is exceeded
+
+// Default algorithm thresholds. See Integer::Thresholds
+#define DEFAULT_KARATSUBA_MULTIPLY_THRESHOLD 32	// <- Min number of words on both operands for Karatsuba multiplication
+#define DEFAULT_NTT_MULTIPLY_THRESHOLD 4096				// <- Min number of words on both operands for NTT multiplication
+#define DEFAULT_NTT_PARALLEL_THRESHOLD 65536			// <- Min NTT length for splitting the transforms across threads
+#define DEFAULT_NTT_BLOCK_SIZE 8192							// <- Number of NTT points processed together inside the cache
+#define DEFAULT_SHORT_PRODUCT_THRESHOLD 96				// <- Min number of words for Karatsuba based short products
+#define DEFAULT_HGCD_THRESHOLD 1500							// <- Min number of words on both operands for half-GCD
+#define PRODUCT_TREE_PARALLEL_WORDS 4096					// <- Min number of words on a product tree level for splitting its products across threads
+#define ACCUMULATOR_MAX_PENDING ((size_t)1 << 31)			// <- Max number of Integers added to an Accumulator between carry propagations
+#define BATCH_MULTIPLY_MAX_WORDS 16							// <- Max number of words of the pairs multiplied lane-parallel by multiply_batch
+#define BATCH_INVERT_PARALLEL_WORDS 16384					// <- Min number of words of a batch inversion (values times modulus words) for splitting it across threads
+
+static_assert(DEFAULT_KARATSUBA_MULTIPLY_THRESHOLD < DEFAULT_NTT_MULTIPLY_THRESHOLD,
+							"Default Karatsuba multiplication threshold must be below the NTT one");
+
+#define SCALAR_MAX_WORDS 5								// <- Max number of words of a native integral value (128 bits)
 
 #define MIN(x,y) (x<y?x:y)			// <- Determines the minimum value between x and y
 #define MAX(x,y) (x>y?x:y)			// <- Determines the maximum value between x and y
 
 /**
- *	@brief Arbitrary-sized binary two's complement Big Integer
+ *	@brief Arbitrary-sized binary Big Integer
  *
- *	Integer binary value is pieced into 31 bits blocks and stored into 32 bits
- *	words. The most significant bit of a word is used for storing the integer
- *	sign, but only the sign bit from the most-significant word stores the actual
- *	integer sign while the sign bits from the rest words remain to 0.
+ *	Integer is stored in sign-magnitude form. The absolute value is pieced into
+ *	31 bits blocks and stored into 32 bits words, less significant word first,
+ *	and the sign is kept apart in a flag, so negation and absolute value do not
+ *	touch the words. The most significant bit of every word remains to 0.
+ *	Bitwise operators emulate the two's complement semantics.
  *
- *	[01]|[01]{31 bits} [- 0|[01]{31 bits} [+]]
+ *	[+-] 0|[01]{31 bits} [- 0|[01]{31 bits} [+]]
  *
  *	Example:
- *	 37650129374_I: 0|0000000000000000000000000010001 - 0|1000100000111110110000111011110
- *	-37650129374_I: 1|1111111111111111111111111101110 - 0|0111011111000001001111000100010
+ *	 37650129374_I: + 0|0000000000000000000000000010001 - 0|1000100000111110110000111011110
+ *	-37650129374_I: - 0|0000000000000000000000000010001 - 0|1000100000111110110000111011110
  *
  */
+class ModInteger;
+
 class Integer {
 
+	friend class ModInteger;
+
 	private:
 
-		std::vector<int32_t> _words;	///<- 32 bits words storing the Integer binary value
+		/**	@brief Words buffer of an Integer. Words are owned by the Integer, or held
+			*	in an immutable reference counted buffer shared by its copies once it is
+			*	shared (copy-on-write). Const accessors read the buffer in use, while non
+			*	const accessors clone a shared buffer before returning it, so only the
+			*	writer pays the copy.
+		*/
+		class Words {
+
+			private:
+
+				std::vector<int32_t> _words;										///<- Owned words. Empty while words are shared
+				std::shared_ptr<std::vector<int32_t>> _shared;	///<- Shared words. Never modified while shared
+
+				/**	@brief Turns the shared words into owned words, cloning them unless no
+					*	other copy shares them, in which case they are taken over.
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				void unshare();
+
+				/**	@brief Gets the owned words, unsharing them beforehand.
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				inline std::vector<int32_t> & own() {
+					if (this->_shared)
+						this->unshare();
+
+					return this->_words;
+				}
+
+				/**	@brief Gets the words in use.
+				*/
+				inline const std::vector<int32_t> & get() const {
+					return this->_shared? *this->_shared : this->_words;
+				}
+
+			public:
+
+				inline Words() = default;
+				inline Words(Words &&) = default;
+				inline Words & operator=(Words &&) = default;
+
+				/**	@brief Copy constructor. Shared words are shared by the copy too.
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				inline Words(const Words & w): _shared(w._shared) {
+					if (!this->_shared)
+						this->_words = w._words;
+				}
+
+				/**	@brief Copy assignment operator. Shared words are shared by the copy
+					*	too, otherwise they are copied into the current capacity.
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				inline Words & operator=(const Words & w) {
+					if (this != &w) {
+						if (w._shared) {
+							this->_shared = w._shared;
+							std::vector<int32_t>().swap(this->_words);
+						}
+						else {
+							this->_words = w._words;
+							this->_shared.reset();
+						}
+					}
+
+					return *this;
+				}
+
+				/**	@brief Moves the owned words into a shared buffer, so copies share them.
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				inline void share() {
+					if (!this->_shared) {
+						this->_words.shrink_to_fit();
+						this->_shared = std::make_shared<std::vector<int32_t>>(std::move(this->_words));
+						this->_words = std::vector<int32_t>();
+					}
+				}
+
+				inline bool shared() const {return (bool)this->_shared;}
+
+				inline operator const std::vector<int32_t> &() const {return this->get();}
+
+				inline size_t size() const {return this->get().size();}
+				inline size_t capacity() const {return this->get().capacity();}
+				inline bool empty() const {return this->get().empty();}
+
+				inline const int32_t * data() const {return this->get().data();}
+				inline int32_t * data() {return this->own().data();}
+
+				inline const int32_t & operator[](size_t i) const {return this->get()[i];}
+				inline int32_t & operator[](size_t i) {return this->own()[i];}
+
+				inline const int32_t & back() const {return this->get().back();}
+				inline int32_t & back() {return this->own().back();}
+
+				inline std::vector<int32_t>::const_iterator begin() const {return this->get().begin();}
+				inline std::vector<int32_t>::iterator begin() {return this->own().begin();}
+				inline std::vector<int32_t>::const_iterator end() const {return this->get().end();}
+				inline std::vector<int32_t>::iterator end() {return this->own().end();}
+
+				inline void resize(size_t n) {this->own().resize(n);}
+				inline void resize(size_t n, int32_t w) {this->own().resize(n, w);}
+				inline void push_back(int32_t w) {this->own().push_back(w);}
+				inline void pop_back() {this->own().pop_back();}
+
+				inline void erase(std::vector<int32_t>::iterator first, std::vector<int32_t>::iterator last) {
+					this->own().erase(first, last);
+				}
+
+				/**	@brief Reserves room for n words. Shared words are cloned only when
+					*	their capacity is exceeded.
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				inline void reserve(size_t n) {
+					if (n > this->capacity())
+						this->own().reserve(n);
+				}
+
+				inline void shrink_to_fit() {
+					if (!this->_shared)
+						this->_words.shrink_to_fit();
+				}
+
+				/**	@brief Clears the words. Shared words are released without cloning.
+				*/
+				inline void clear() {
+					this->_shared.reset();
+					this->_words.clear();
+				}
+
+				/**	@brief Replaces the words by the [first, last) ones. Shared words are
+					*	released without cloning, after copying the range since it may point
+					*	to them.
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				template <class IT>
+				inline void assign(IT first, IT last) {
+					if (this->_shared) {
+						std::vector<int32_t> words(first, last);
+
+						this->_shared.reset();
+						this->_words.swap(words);
+					}
+					else
+						this->_words.assign(first, last);
+				}
+
+				/**	@brief Keeps the first n words, n not exceeding the current size.
+					*	Shared words are released, only the kept ones being copied.
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				inline void truncate(size_t n) {
+					if (this->_shared) {
+						std::vector<int32_t> words(this->_shared->begin(), this->_shared->begin() + n);
+
+						this->_shared.reset();
+						this->_words.swap(words);
+					}
+					else
+						this->_words.resize(n);
+				}
+
+				/**	@brief Swaps the owned words with the given ones. Shared words are
+					*	released without cloning, words getting no words back.
+				*/
+				inline void swap(std::vector<int32_t> & words) {
+					this->_shared.reset();
+					this->_words.swap(words);
+				}
+
+				inline void swap(Words & w) {
+					this->_words.swap(w._words);
+					this->_shared.swap(w._shared);
+				}
+		};
+
+		Words _words;									///<- 32 bits words storing the Integer absolute value
+		bool _negative;								///<- Integer holds a negative value. Always false on zero
 		bool _modified;								///<- Integer has been modified since last Integer decimal value computation
 
 		/** Stores the 10-base Integer representation when conversion to string is
@@ -45,6 +251,10 @@ class Integer {
 
 		static std::default_random_engine _random_engine; ///<- Random engine
 
+		static size_t _n_threads; ///<- Max number of threads used by parallel algorithms
+
+		static double _growth_factor; ///<- Factor applied to the words capacity when it is exceeded
+
 		/**
 		 * @brief Reading from stream states declaration
 		 *
@@ -54,36 +264,18 @@ class Integer {
 
 		/////	Private methods /////
 
-		/**	@brief Used for removing redundant words having 0 or -1 value before
-			*	the most significant word.
+		/**	@brief Used for removing redundant words having 0 value before the
+			*	most significant word. The sign is cleared on zero.
 			* @throw std::bad_alloc on memory allocation error
 			*/
 		void fix();
 
-		/**	@brief Splits current word set into two subsets stored into two new two
-			*	Integers where first Integer is comprised by the part_size less
-			*	significant words and the second one comprises the rest of words
-			*
-			*	@param n1 First returning Integer containing the "tam" less significant words.
-			*	@param n2 First returning Integer containing the the rest of words.
-			*	@param part_size number of words for the first subset.
-			* @note Const method that does not modify current Integer.
+		/**	@brief Replaces the words holding a negative value in two's complement
+			*	(as left by a subtraction borrowing out of the most significant word)
+			*	by its absolute value and flips the sign.
 			* @throw std::bad_alloc on memory allocation error
 		*/
-		void split(Integer & n1, Integer & n2, size_t part_size) const;
-
-		/**	@brief Adds "n2" 32 bits integer to "n1" Integer by starting at the word
-			* indexed by index. Resulting value is stored in the current Integer.
-		 	*
-			*	@param n1 First Integer operand
-			*	@param n2 Second 32 bits integer operand.
-			*	@param index: n1 word index where the addition starts.
-			* @overload
-			* @throw std::bad_alloc on memory allocation error
-			*
-			*	@pre index must be a valid integer  0 <= index < n1._words.size()
-		*/
-		void add(const Integer & n1, int32_t n2, size_t index);
+		void complement_words();
 
 		/**	@brief Adds two Integers. If negative flag is set to true, the second
 		  *	operand n2 is turned negative before the addition. Resulting Integer is
@@ -109,9 +301,219 @@ class Integer {
 		*/
 		void multiply(const Integer & n1, const Integer & n2);
 
+		/**	@brief Multiplies two Integers word by word (schoolbook algorithm) and
+			*	saves the result into the current Integer.
+			* @throw std::bad_alloc on memory allocation error
+			*
+			*	@param n1 First Integer operand
+			*	@param n2 Second Integer operand
+		*/
+		void multiply_schoolbook(const Integer & n1, const Integer & n2);
+
+		/**	@brief Multiplies two Integers through Karatsuba algorithm and saves
+			*	the result into the current Integer. Halves of the operands are handled
+			*	as words ranges in place and partial products are written into a
+			*	workspace allocated once for the whole recursion.
+			* @throw std::bad_alloc on memory allocation error
+			*
+			*	@param n1 First Integer operand
+			*	@param n2 Second Integer operand
+		*/
+		void multiply_karatsuba(const Integer & n1, const Integer & n2);
+
+		/**	@brief Multiplies two Integers through a Number Theoretic Transform
+			*	(three primes NTT and CRT reconstruction) and saves the result into the
+			*	current Integer. Transforms, pointwise products and carry propagation
+			*	are split across threads for big operands.
+			* @throw std::bad_alloc on memory allocation error
+			*
+			*	@param n1 First Integer operand
+			*	@param n2 Second Integer operand
+			*	@pre n1 and n2 words must not exceed together the max NTT length (2^23).
+		*/
+		void multiply_ntt(const Integer & n1, const Integer & n2);
+
+		/**	@brief Multiplies the positive 31 bits words sequences a and b (less
+			*	significant word first) and writes the na+nb words of the product into r.
+			*	Schoolbook, Karatsuba or NTT algorithm is selected by the thresholds.
+			* @throw std::bad_alloc on memory allocation error
+			*
+			*	@param r Output words. It must have room for na+nb words.
+			*	@param a First operand words
+			*	@param na Number of words of a
+			*	@param b Second operand words
+			*	@param nb Number of words of b
+		*/
+		static void multiply_words(int32_t * r, const int32_t * a, size_t na,
+																const int32_t * b, size_t nb);
+
+		/**	@brief Writes the n less significant words of the product of the n
+			*	words sequences a and b into r.
+			* @throw std::bad_alloc on memory allocation error
+			*	@see mul_low
+		*/
+		static void mul_low_words(int32_t * r, const int32_t * a, const int32_t * b, size_t n);
+
+		/**	@brief Writes the approximated n most significant words of the 2n words
+			*	product of the n words sequences a and b into r.
+			* @throw std::bad_alloc on memory allocation error
+			*	@see mul_high
+		*/
+		static void mul_high_words(int32_t * r, const int32_t * a, const int32_t * b, size_t n);
+
+		/**	@brief Unimodular 2x2 matrix relating the operands of a gcd to their
+			*	reduced values. Defined in integer.cpp.
+		*/
+		struct CofactorMatrix;
+
+		/**	@brief Reduces a and b (a >= b >= 0) by Euclidean steps until b has no
+			*	more than half the bits of a (half-GCD). Above the hgcd threshold the
+			*	reduction is computed recursively on the most significant bits, below
+			*	it through Lehmer steps.
+			* @throw std::bad_alloc on memory allocation error
+			*
+			*	@param a First operand, replaced by the reduced one
+			*	@param b Second operand, replaced by the reduced one (a >= b >= 0)
+			*	@param M Matrix right multiplied by the reduction, so that M times the
+			*		reduced operands remains constant. Cofactors are not computed when null.
+		*/
+		static void half_gcd(Integer & a, Integer & b, CofactorMatrix * M);
+
+		/**	@brief Reduces a and b (a >= b >= 0) through Lehmer steps until b has
+			*	no more than n_bits bits, or slightly less.
+			* @throw std::bad_alloc on memory allocation error
+			*	@see half_gcd
+		*/
+		static void lehmer_reduce(Integer & a, Integer & b, size_t n_bits, CofactorMatrix * M);
+
+		/**	@brief Reduces a and b (a >= b >= 0) through half-GCDs followed by
+			*	division steps until b falls below the hgcd threshold.
+			* @throw std::bad_alloc on memory allocation error
+			*	@see half_gcd
+		*/
+		static void gcd_reduce(Integer & a, Integer & b, CofactorMatrix * M);
+
+		/**	@brief Square root with remainder of n >= 0 through Zimmermann's
+			*	Karatsuba square root: the root of the most significant half is
+			*	computed recursively and the lower half of the root is obtained by a
+			*	division. Values up to 64 bits are solved natively.
+			* @throw std::bad_alloc on memory allocation error
+			*
+			*	@param n Radicand
+			*	@param s Output root, floor(sqrt(n))
+			*	@param r Output remainder, n - s^2
+		*/
+		static void sqrtrem_karatsuba(const Integer & n, Integer & s, Integer & r);
+
+		/**	@brief Replaces the current Integer words by the passed positive 31 bits
+			*	words sequence (less significant word first) and removes the redundant
+			*	words.
+			*
+			*	@param words Words sequence. Its content is copied when it fits in the
+			*		current capacity, otherwise it is moved into the current Integer.
+			*	@param negative Whether the value is negative. Default value is false
+			* @throw std::bad_alloc on memory allocation error
+		*/
+		void assign_words(std::vector<int32_t> & words, bool negative=false);
+
+		/**	@brief Adds (or subtracts) the positive 31 bits words sequence p (less
+			*	significant word first) to the current Integer in place. Magnitudes are
+			*	added or subtracted depending on the signs, and words are only visited
+			*	while the carry (or borrow) propagates over p.
+			*
+			*	@param p Words to be accumulated
+			*	@param np Number of words of p
+			*	@param subtract Whether p is subtracted instead of added
+			* @throw std::bad_alloc on memory allocation error
+		*/
+		void accumulate_words(const int32_t * p, size_t np, bool subtract);
+
+		/**	@brief Gets the magnitude and the sign of an integral value. Every
+			*	integral type up to 128 bits (__int128 on GNU mode included) is
+			*	supported.
+			*
+			*	@param n Integral value
+			*	@param negative Receives whether n is negative
+			*	@return Absolute value of n
+		*/
+		template <class INT_T>
+		inline static unsigned __int128 scalar_magnitude(INT_T n, bool & negative) {
+			negative = std::is_signed<INT_T>::value && n < (INT_T)0;
+			return negative? -(unsigned __int128)n : (unsigned __int128)n;
+		}
+
+		/**	@brief Adds 1 to the current Integer in place. Words are only visited
+			*	while the carry propagates, so the cost is amortized O(1). The most
+			*	significant word is only updated when the carry reaches it.
+		*/
+		void increment();
+
+		/**	@brief Subtracts 1 from the current Integer in place. Words are only
+			*	visited while the borrow propagates, so the cost is amortized O(1).
+			*	The most significant word is only updated when the borrow reaches it.
+		*/
+		void decrement();
+
+		/**	@brief Adds (or subtracts) a native scalar to the current Integer in
+			*	place, working straight on the words. The words vector only grows
+			*	when the result needs a new word.
+			*
+			*	@param m Magnitude of the scalar
+			*	@param subtract Whether m is subtracted instead of added
+			* @throw std::bad_alloc on memory allocation error
+		*/
+		void add_scalar(unsigned __int128 m, bool subtract);
+
+		/**	@brief Multiplies the current Integer by a native scalar in place, on a
+			*	single pass over the words.
+			*
+			*	@param m Magnitude of the scalar
+			*	@param negative Whether the scalar is negative
+			* @throw std::bad_alloc on memory allocation error
+		*/
+		void multiply_scalar(unsigned __int128 m, bool negative);
+
+		/**	@brief Copy constructor reserving room for extra words, so scalar
+			*	kernels applied to the copy do not reallocate its words.
+			*
+			*	@param n Integer to be copied
+			*	@param extra_words Number of words to be reserved over the size of n
+			* @throw std::bad_alloc on memory allocation error
+		*/
+		inline Integer(const Integer & n, size_t extra_words):
+									_negative(n._negative), _modified(true) {
+			_words.reserve(n._words.size() + extra_words);
+			_words.assign(n._words.begin(), n._words.end());
+		}
+
+		/**	@brief Adds (or subtracts) the product a*m to the current Integer in
+			*	place. Words of the product are computed and accumulated in a single
+			*	pass without intermediate storage. a may be the current Integer.
+			*
+			*	@param a Integer operand
+			*	@param m Scalar operand
+			*	@param subtract Whether the product is subtracted instead of added
+			* @throw std::bad_alloc on memory allocation error
+		*/
+		void accumulate_scalar_product(const Integer & a, uint64_t m, bool subtract);
+
+		/**	@brief Adds (or subtracts) the product a*b to the current Integer in
+			*	place. Operands up to 2 words are handled as scalars, bigger products
+			*	are computed into a per thread buffer reused across calls. a and b may
+			*	be the current Integer.
+			*
+			*	@param a First Integer operand
+			*	@param b Second Integer operand
+			*	@param subtract Whether the product is subtracted instead of added
+			* @throw std::bad_alloc on memory allocation error
+		*/
+		void accumulate_product(const Integer & a, const Integer & b, bool subtract);
+
 		/**	@brief Performs integer division between the current Integer and the
 			*	divisor d and returns both quotient and remainder into the
-			*	passed passed Integer objects.
+			*	passed passed Integer objects. Absolute values are divided word by
+			*	word (Knuth's long division) on words buffers, normalized once when
+			*	they are stored into quotient and remainder.
 			*
 			*	@param d The Integer divisor of the operation
 			*	@param quotient Output Integer quotient
@@ -126,7 +528,8 @@ class Integer {
 		void divide(const Integer & d, Integer & quotient, Integer & remainder) const;
 
 		/** @brief Computes the power of current integer to the exponent and stores
-			* 	the result into the current Integer.
+			* 	the result into the current Integer. Bases 0 and +-1 are solved
+			*	directly and powers of 2 as shifts.
 			*	@param exp Integer with exponent
 		  * @pre exp must be positive
 			* @throw std::bad_alloc on memory allocation error
@@ -134,11 +537,26 @@ class Integer {
 		*/
 		void power(const Integer & exp);
 
-		/**
-			* @brief Converts the current Integer into negative
+		/**	@brief Computes the power of current Integer to the exponent exp through
+			*	left-to-right sliding window exponentiation, and stores the result into
+			*	the current Integer. Odd powers up to the window size are precomputed.
+			*	Squarings and products are written into two buffers sized for the
+			*	result, used in turn.
+			*
+			*	@param exp Positive exponent
+			*	@param n_bits_max Max number of bits of the result
 			* @throw std::bad_alloc on memory allocation error
 		*/
-		inline void negative() {this->bitwise_not();	this->add(*this,1,0); this->fix();};
+		void power_window(const Integer & exp, size_t n_bits_max);
+
+		/**
+			* @brief Converts the current Integer into negative. Only the sign is
+			*	flipped, zero keeps the positive sign.
+		*/
+		inline void negative() {
+			this->_negative = !this->_negative && !this->is_zero();
+			this->_modified = true;
+		};
 
 		/**	@brief Compares current Integer value to another Integer value.
 			*
@@ -153,6 +571,33 @@ class Integer {
 		*/
 		int compare(const Integer & n) const;
 
+		/**	@brief Compares current Integer value to a native scalar without
+			*	building an Integer. Words of the scalar are laid out on the stack and
+			*	compared from the most significant one.
+			*
+			*	@param m Magnitude of the scalar
+			*	@param negative Whether the scalar is negative
+			*	@return -1, 0 or 1 whether current Integer value is lower, equal or
+			*		greater than the scalar.
+			*	@note Const method that does not modify the current Integer
+		*/
+		int compare_scalar(unsigned __int128 m, bool negative) const;
+
+		/**	@brief Compares current Integer value to a decimal integer written in
+			*	a string. Strings up to 38 digits are compared as native scalars and
+			*	longer ones are resolved by signs and number of digits or against the
+			*	cached decimal representation. Only when none of them decides, the
+			*	string is converted into an Integer.
+			*
+			*	@param n String containing the integer decimal representation.
+			*	@return -1, 0 or 1 whether current Integer value is lower, equal or
+			*		greater than the string value.
+			* @throw std::invalid_argument when input string contains a
+			*	non-valid integer decimal character.
+			*	@note Const method that does not modify the current Integer
+		*/
+		int compare_string(std::string_view n) const;
+
 		//	Bitwise operations
 
 		/**
@@ -192,7 +637,8 @@ class Integer {
 
 		///	Utils
 
-		/**	@brief Resizes the number of words on current Integer.
+		/**	@brief Resizes the number of words on current Integer. New words are set
+			*	to 0 and, when the capacity is exceeded, it grows by the growth factor.
 			*
 			*	@param n New number of words
 			* @throw std::bad_alloc on memory allocation error
@@ -203,9 +649,10 @@ class Integer {
 			*	@brief Resets Integer value to the initial value 0.
 			* @throw std::bad_alloc on memory allocation error
 		*/
-		void reset() {_words.resize(1);	_words.back() = 0;	_modified = true;};
+		void reset() {_words.truncate(1);	_words[0] = 0;	_negative = false;	_modified = true;};
 
-		/**	@brief Finds most significant 1 bit index on the current Integer.
+		/**	@brief Finds most significant 1 bit index on the absolute value of the
+			*	current Integer.
 			*	@return Most significant 1 bit index.
 			*
 			*	@note Const method that does not modify the current Integer
@@ -256,13 +703,370 @@ class Integer {
 				}
 		};
 
+		////	Algorithm thresholds ////
+
+		/**
+			* @brief Crossover points between the algorithms implementing the same
+			*	operation. Sizes are given in number of words.
+			*
+			*	Thresholds depend on the host CPU. Tuned values can be generated by
+			*	the tune_integer tool and applied at runtime through set_thresholds or
+			*	load_thresholds without recompiling.
+		*/
+		struct Thresholds {
+			size_t karatsuba_multiply = DEFAULT_KARATSUBA_MULTIPLY_THRESHOLD;	///<- Min words on both operands for Karatsuba multiplication
+			size_t ntt_multiply = DEFAULT_NTT_MULTIPLY_THRESHOLD;							///<- Min words on both operands for NTT multiplication
+			size_t ntt_parallel = DEFAULT_NTT_PARALLEL_THRESHOLD;							///<- Min NTT length for splitting the transforms across threads
+			size_t ntt_block = DEFAULT_NTT_BLOCK_SIZE;												///<- NTT points processed together inside the cache (power of 2)
+			size_t short_product = DEFAULT_SHORT_PRODUCT_THRESHOLD;						///<- Min words for Karatsuba based short products
+			size_t hgcd = DEFAULT_HGCD_THRESHOLD;															///<- Min words on both operands for half-GCD
+		};
+
+	private:
+
+		static Thresholds _thresholds; ///<- Algorithm thresholds currently applied
+
+	public:
+
+		////	Product trees ////
+
+		/**
+			* @brief Balanced binary tree of products over a sequence of Integers.
+			*
+			*	Level 0 holds the leaves. Node j of level i is the product of nodes
+			*	2j and 2j+1 of level i-1, or a copy of node 2j when it has no sibling.
+			*	The last level holds a single node, the product of every leaf. Kept
+			*	for algorithms walking the tree downwards (i.e remainder trees).
+		*/
+		class ProductTree {
+			public:
+
+				/**	@brief Builds the product tree of the given leaves. The products of
+					*	each level are split across threads when the level is large enough.
+					*
+					* @param leaves Leaves of the tree.
+					* @throw std::bad_alloc on memory allocation error
+					* @throw std::invalid_argument when leaves is empty.
+				*/
+				explicit ProductTree(std::span<const Integer> leaves);
+
+				/**	@brief Gets the number of levels of the tree, leaves included.
+				*/
+				inline size_t levels() const {return _levels.size();};
+
+				/**	@brief Gets the nodes of a level of the tree. Level 0 holds the leaves.
+					*
+					* @param i Level index, lower than levels().
+				*/
+				inline const std::vector<Integer> & level(size_t i) const {return _levels[i];};
+
+				/**	@brief Gets the root of the tree, the product of every leaf.
+				*/
+				inline const Integer & root() const {return _levels.back()[0];};
+
+			private:
+				std::vector<std::vector<Integer> > _levels; ///<- Nodes of every level, leaves first
+		};
+
+		////	Accumulators ////
+
+		/**
+			* @brief Sum of a long stream of Integers and integral values.
+			*
+			*	Integral values are summed on a 128 bits native buffer. Words of the
+			*	Integers are summed on 64 bits lanes without propagating their carries,
+			*	so every addition takes a single pass with no normalization. Carries
+			*	are only propagated every ACCUMULATOR_MAX_PENDING additions and when
+			*	the result is requested. Accumulators filled by several threads can be
+			*	merged for parallel reductions.
+		*/
+		class Accumulator {
+			public:
+
+				/**	@brief Constructs an Accumulator holding 0.
+				*/
+				inline Accumulator(): _small(0), _pending(0) {};
+
+				/**	@brief Adds an integral value. Values up to 64 bits are summed
+					*	natively, 128 bits ones are added as Integers.
+					*	@throw std::bad_alloc on memory allocation error
+				*/
+				template <class INT_T,
+								class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
+				inline Accumulator & operator+=(INT_T n) {
+					if constexpr (sizeof(INT_T) > sizeof(int64_t))
+						this->add_words(Integer(n), false);
+					else
+						this->add_small(n);
+
+					return *this;
+				}
+
+				/**	@brief Subtracts an integral value. Values up to 64 bits are summed
+					*	natively, 128 bits ones are subtracted as Integers.
+					*	@throw std::bad_alloc on memory allocation error
+				*/
+				template <class INT_T,
+								class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
+				inline Accumulator & operator-=(INT_T n) {
+					if constexpr (sizeof(INT_T) > sizeof(int64_t))
+						this->add_words(Integer(n), true);
+					else
+						this->add_small(-(__int128)n);
+
+					return *this;
+				}
+
+				/**	@brief Adds an Integer.
+					*	@throw std::bad_alloc on memory allocation error
+				*/
+				inline Accumulator & operator+=(const Integer & n) {
+					this->add_words(n, false);
+					return *this;
+				}
+
+				/**	@brief Subtracts an Integer.
+					*	@throw std::bad_alloc on memory allocation error
+				*/
+				inline Accumulator & operator-=(const Integer & n) {
+					this->add_words(n, true);
+					return *this;
+				}
+
+				/**	@brief Adds the sum held by other Accumulator.
+					*	@throw std::bad_alloc on memory allocation error
+				*/
+				Accumulator & merge(const Accumulator & other);
+
+				/**	@brief Computes the sum of every value added.
+					*	@throw std::bad_alloc on memory allocation error
+					*	@note Const method that does not modify the Accumulator.
+				*/
+				Integer result() const;
+
+				/**	@brief Sets the Accumulator to 0.
+				*/
+				inline void reset() {
+					this->_lanes.clear();
+					this->_small = 0;
+					this->_pending = 0;
+				}
+
+			private:
+				std::vector<int64_t> _lanes;	///<- Sum of the words of the Integers at every position (31 bits shifted)
+				__int128 _small;							///<- Sum of the integral values
+				size_t _pending;							///<- Additions into the lanes since the last carry propagation
+
+				/**	@brief Adds v to the native buffer. The buffer is moved into the
+					*	lanes when it would overflow.
+				*/
+				inline void add_small(__int128 v) {
+					__int128 sum;
+
+					if (__builtin_add_overflow(this->_small, v, &sum)) {
+						this->fold_small();
+						sum = v;
+					}
+
+					this->_small = sum;
+				}
+
+				/**	@brief Adds (or subtracts) the words of n to the lanes.
+				*/
+				void add_words(const Integer & n, bool subtract);
+
+				/**	@brief Moves the native buffer into the lanes.
+				*/
+				void fold_small();
+
+				/**	@brief Propagates the carries of the lanes, leaving 31 bits words on
+					*	every lane but the most significant one.
+				*/
+				void normalize();
+		};
+
+		////	Modular arithmetic ////
+
+		/**
+			* @brief Precomputed context for Montgomery multiplication modulo a fixed
+			*	odd modulus m of n words.
+			*
+			*	Values are kept in Montgomery form a*R mod m, being R = 2^(31n), so
+			*	products are reduced by REDC with no division. Small moduli interleave
+			*	the product and the reduction word by word, big ones reduce Karatsuba
+			*	products. Contexts are immutable, so they can be shared by threads.
+		*/
+		class MontgomeryContext {
+			public:
+
+				/**	@brief Precomputes the context of the modulus mod.
+					*
+					* @param mod Odd modulus greater than 1.
+					* @throw std::bad_alloc on memory allocation error
+					* @throw std::invalid_argument when mod is not odd or lower than 3.
+				*/
+				explicit MontgomeryContext(const Integer & mod);
+
+				/**	@brief Gets the modulus.
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				Integer modulus() const;
+
+				/**	@brief Gets the number of words of the modulus.
+				*/
+				inline size_t size() const {return _m.size();};
+
+				/**	@brief Converts a into Montgomery form, a*R mod m. Negative values and
+					*	values over the modulus are reduced beforehand.
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				Integer to_montgomery(const Integer & a) const;
+
+				/**	@brief Converts a from Montgomery form, a/R mod m.
+					* @pre 0 <= a < m
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				Integer from_montgomery(const Integer & a) const;
+
+				/**	@brief Montgomery product a*b/R mod m of two values in Montgomery form.
+					* @pre 0 <= a, b < m
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				Integer multiply(const Integer & a, const Integer & b) const;
+
+				/**	@brief Computes base^exp mod m through sliding window exponentiation
+					*	on Montgomery form. Base and result are not in Montgomery form.
+					*
+					* @param base Base of the power. It is reduced beforehand.
+					*	@param exp Exponent of the power.
+					* @throw std::bad_alloc on memory allocation error
+					* @throw std::invalid_argument when exp is negative.
+				*/
+				Integer power(const Integer & base, const Integer & exp) const;
+
+			private:
+				std::vector<int32_t> _m;		///<- Words of the modulus
+				std::vector<int32_t> _one;	///<- R mod m, 1 in Montgomery form (n words)
+				std::vector<int32_t> _r2;		///<- R^2 mod m, used for conversions into Montgomery form (n words)
+				uint32_t _m_inv;						///<- -m^-1 mod 2^31
+
+				/**	@brief Writes the n words of a, reduced modulo m, into r.
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				void load(int32_t * r, const Integer & a) const;
+
+				/**	@brief Writes the n words of base^exp into r, both in Montgomery form.
+					*	r may be base.
+					* @pre exp must be positive
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				void power_words(int32_t * r, const int32_t * base, const Integer & exp) const;
+
+				friend class ModInteger;
+		};
+
+		/**
+			* @brief Precomputed context for Barrett reduction modulo a fixed modulus m
+			*	of n words, odd or even.
+			*
+			*	mu = floor(4^k / m), being k = 31n, is computed once, so reductions of
+			*	values lower than 4^k take two short multiplications and a correction
+			*	instead of a general division. Operations run on buffers of n words.
+			*	Contexts are immutable, so they can be shared by threads.
+		*/
+		class BarrettContext {
+			public:
+
+				/**	@brief Precomputes the context of the modulus mod.
+					*
+					* @param mod Positive modulus.
+					* @throw std::bad_alloc on memory allocation error
+					* @throw std::invalid_argument when mod is negative.
+					* @throw zero_division_error when mod is zero
+				*/
+				explicit BarrettContext(const Integer & mod);
+
+				/**	@brief Gets the modulus.
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				Integer modulus() const;
+
+				/**	@brief Gets the number of words of the modulus.
+				*/
+				inline size_t size() const {return _n;};
+
+				/**	@brief Computes a mod m, in [0, m), for any value a. Values over 4^k
+					*	are reduced by chunks of n words from the most significant one.
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				Integer reduce(const Integer & a) const;
+
+				/**	@brief Computes a*b mod m. Operands are reduced beforehand.
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				Integer mulmod(const Integer & a, const Integer & b) const;
+
+				/**	@brief Computes a^2 mod m. The operand is reduced beforehand.
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				Integer sqrmod(const Integer & a) const;
+
+				/**	@brief Computes a+b mod m. Operands are reduced beforehand.
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				Integer addmod(const Integer & a, const Integer & b) const;
+
+				/**	@brief Computes base^exp mod m through sliding window exponentiation.
+					*
+					* @param base Base of the power. It is reduced beforehand.
+					*	@param exp Exponent of the power.
+					* @throw std::bad_alloc on memory allocation error
+					* @throw std::invalid_argument when exp is negative.
+				*/
+				Integer power(const Integer & base, const Integer & exp) const;
+
+			private:
+				size_t _n;									///<- Number of words of the modulus
+				std::vector<int32_t> _m;		///<- Words of the modulus, plus a zero word (n+1 words)
+				std::vector<int32_t> _mu;		///<- floor(4^k / m), bounded to n+1 words
+
+				/**	@brief Number of words of workspace required by the words operations.
+				*/
+				size_t workspace() const;
+
+				/**	@brief Writes the n words of x mod m into r, for the 2n words x.
+					* @param ws Workspace of workspace() words.
+				*/
+				void reduce_words(int32_t * r, const int32_t * x, int32_t * ws) const;
+
+				/**	@brief Writes the n words of a*b mod m into r, for the n words a and b
+					*	lower than m. r may be a or b.
+					* @param ws Workspace of workspace() words.
+				*/
+				void mulmod_words(int32_t * r, const int32_t * a, const int32_t * b, int32_t * ws) const;
+
+				/**	@brief Writes the n words of a, reduced modulo m, into r.
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				void load(int32_t * r, const Integer & a) const;
+
+				/**	@brief Writes the n words of base^exp mod m into r, for the n words
+					*	base lower than m. r may be base.
+					* @pre exp must be positive
+					* @throw std::bad_alloc on memory allocation error
+				*/
+				void power_words(int32_t * r, const int32_t * base, const Integer & exp) const;
+
+				friend class ModInteger;
+		};
+
 		////	Constructors ////
 
 		/**	@brief Default constructor
 			*	Constructs Integer to the default value 0.
 		 	*	@overload
 		*/
-		inline Integer(): _modified(true) {_words.resize(1);};
+		inline Integer(): _negative(false), _modified(true) {_words.resize(1);};
 
 		/**	@brief Integral Constructor
 			*	Constructs an Integer from any integral type.
@@ -274,35 +1078,15 @@ class Integer {
 		*/
 		template <class INT_T,
 						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
-				Integer(INT_T n) {
-
-						int32_t aux;
-
-						//integer is splitted into 32 bits	integers if is longer.
-						while(n!=0 && (!std::is_signed<INT_T>::value || n!=-1)) {
+				Integer(INT_T n): _modified(true) {
 
-							if (n >= INT32_MIN && n <= INT32_MAX)
-								//last 32 bit integer is readen
-								aux = n & (int32_t)0xffffffff;
-							else
-								//Not last 32 bit integer is readen without the sig bit (31 bits)
-								aux = n & (int32_t)0x7fffffff;
+						//Absolute value is splitted into 31 bits words
+						unsigned __int128 m = scalar_magnitude(n, this->_negative);
 
-							//Store the readen word
-							this->resize(this->_words.size() + (size_t)1);
-							this->_words.back() = aux;
-
-							//Shift to retrieve next word
-							n >>= 31;
-						}
-
-						//integer initially stores 0 or -1 value and it is directly inserted.
-						if (_words.empty()) {
-							this->resize((size_t)1);
-							this->_words.back() = n;
-						}
-
-					this->_modified=true;
+						do {
+							this->_words.push_back((int32_t)(m & 0x7fffffff));
+							m >>= 31;
+						} while (m != 0);
 				}
 
 		/**	@brief String constructor
@@ -332,6 +1116,7 @@ class Integer {
 		*/
 		Integer(const Integer & n) {
 			this->_words = n._words;
+			this->_negative = n._negative;
 			this->_str_fmt_cache = n._str_fmt_cache;
 			this->_modified = n._modified;
 
@@ -346,7 +1131,7 @@ class Integer {
 		/**	@brief Checks whether the Integer has a negative value or not.
 			*	@note Const method that does not modify the current Integer.
 		*/
-		inline bool is_negative() const {return _words.back() < 0;};
+		inline bool is_negative() const {return _negative;};
 
 		/**	@brief Checks whether the Integer value is zero or not.
 			*	@note Const method that does not modify the current Integer.
@@ -358,10 +1143,11 @@ class Integer {
 		*/
 		inline bool is_even() const {return (_words[0] & 0x00000001) == 0;};
 
-		/** @brief Counts the actual number of bits taken by the Integer value.
+		/** @brief Counts the actual number of bits taken by the Integer value,
+			*	sign bit included on negative values.
 			*	@note Const method that does not modify the current Integer
 		*/
-		inline size_t n_bits() const {return this->findFirstOne() + 1;};
+		inline size_t n_bits() const {return this->findFirstOne() + 1 + this->_negative;};
 
 		/**
 			* @brief Gets current random engine used for Integer random value generation.
@@ -371,6 +1157,46 @@ class Integer {
 			return Integer::_random_engine;
 		}
 
+		/**
+			* @brief Gets the max number of threads used by parallel algorithms.
+			*	@note The number of threads is generic for the whole class
+		*/
+		inline static size_t get_n_threads() {
+			return Integer::_n_threads;
+		}
+
+		/**
+			* @brief Gets the factor applied to the words capacity when it is exceeded.
+			*	@note The growth factor is generic for the whole class
+		*/
+		inline static double get_growth_factor() {
+			return Integer::_growth_factor;
+		}
+
+		/**
+			* @brief Number of bits the current Integer can hold without reallocating
+			*	its words.
+		*/
+		inline size_t capacity_bits() const {
+			return this->_words.capacity() * N_BITS_PER_WORD;
+		}
+
+		/**
+			* @brief Checks whether the current Integer words are shared with its
+			*	copies. See share().
+		*/
+		inline bool is_shared() const {
+			return this->_words.shared();
+		}
+
+		/**
+			* @brief Gets the algorithm thresholds currently applied.
+			*	@note The thresholds are generic for the whole class
+		*/
+		inline static const Thresholds & get_thresholds() {
+			return Integer::_thresholds;
+		}
+
 		//// Helper functions /////
 
 		/** @brief Replaces current Integer value by another pseudo-randomly
@@ -393,6 +1219,7 @@ class Integer {
 		*/
 		inline const Integer & operator=(const Integer & n) {
 			this->_words = n._words;
+			this->_negative = n._negative;
 			this->_str_fmt_cache = n._str_fmt_cache;
 			this->_modified = n._modified;
 
@@ -421,41 +1248,22 @@ class Integer {
 
 			this->_words.clear();
 
-			/*whether integer has more bits than int32_t, it must be splitted into
-			 *32-bits blocks*/
-				int32_t aux;
+			//Absolute value is splitted into 31 bits words
+			unsigned __int128 m = scalar_magnitude(n, this->_negative);
 
-				//Split integer into 32-bits blocks until redundant block (0 or -1) is found
-				while(n!=0 && (!std::is_signed<INT_T>::value || n!=-1)) {
-
-					/*Check if last block will be extracted so it must be extracted with
-					 *the sign bit*/
-					if ((n>=0 && n<=INT32_MAX) || (n<0 && n>=INT32_MIN))
-						aux= n & (int32_t)-1;
-					else
-						aux= n & (int32_t)0x7fffffff;
-
-					this->resize(this->_words.size() + (size_t)1);
-					this->_words.back() = aux;
-
-					n >>= 31;	//Shift right to take the next block
-				}
-
-				//Add the integer if originally was 0 or -1 (considered by the loop redundant)
-				if (_words.empty()) {
-					this->resize((size_t)1);
-					this->_words.back() = n;
-				}
+			do {
+				this->_words.push_back((int32_t)(m & 0x7fffffff));
+				m >>= 31;
+			} while (m != 0);
 
 			_modified=true;
 
 			//Check postcondition
 			#ifdef DEBUG
 
-				assert(!(this->_words.size() > 1) ||
-										(this->_words.back() != 0 && this->_words.back() != -1));
+				assert(!(this->_words.size() > 1) || this->_words.back() != 0);
 
-				for (size_t i = 0; i < this->_words.size()-1; i++)
+				for (size_t i = 0; i < this->_words.size(); i++)
 					assert((this->_words[i] & 0x80000000) == 0);
 
 			#endif
@@ -465,7 +1273,7 @@ class Integer {
 
 		/**	@brief String assignment operator
 			*	Copies integer written as decimal into a string into the current Integer
-			*	by converting into two's complement binary.
+			*	by converting into binary.
 			*
 			*	@param n String containing decimal Integer representation.
 			*
@@ -484,7 +1292,7 @@ class Integer {
 
 		/**	@brief C-String assignment operator
 			*	Copies integer written as decimal into a c-string (char array ended with
-			*	\0) into the current Integer by converting into two's complement binary.
+			*	\0) into the current Integer by converting into binary.
 			*
 			*	@param n C-string containing decimal Integer representation.
 			*
@@ -533,10 +1341,11 @@ class Integer {
 		template <class INT_T,
 						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
 		inline Integer operator+(INT_T n) const {
-			Integer ret, opn(n);
+			Integer ret(*this, SCALAR_MAX_WORDS + 1);
+			bool negative;
+			const unsigned __int128 m = scalar_magnitude(n, negative);
 
-			ret.add(*this, opn);
-			ret._modified = true;
+			ret.add_scalar(m, negative);
 
 			return ret;
 		}
@@ -559,12 +1368,7 @@ class Integer {
 		template <class INT_T,
 						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
 		friend inline Integer operator+(INT_T n, const Integer & i) {
-			Integer ret, opn(n);
-
-			ret.add(opn, i);
-			ret._modified = true;
-
-			return ret;
+			return i + n;
 		}
 
 		/**	@brief String add operator.
@@ -682,10 +1486,10 @@ class Integer {
 		template <class INT_T,
 						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
 		inline const Integer & operator+=(INT_T n) {
-			Integer opn(n);
+			bool negative;
+			const unsigned __int128 m = scalar_magnitude(n, negative);
 
-			this->add(*this, opn);
-			this->_modified = true;
+			this->add_scalar(m, negative);
 			return *this;
 		}
 
@@ -737,9 +1541,7 @@ class Integer {
 			* @throw std::bad_alloc on memory allocation error
 		*/
 		inline const Integer & operator++() {
-			this->add(*this,1,0);
-			this->fix();
-			this->_modified = true;
+			this->increment();
 
 			return *this;
 		}
@@ -753,11 +1555,7 @@ class Integer {
 		inline Integer operator++(int) {
 			Integer r(*this);
 
-			this->add(*this,1,0);
-			this->fix();
-			this->_modified = true;
-
-			r._modified = true;
+			this->increment();
 
 			return r;
 		}
@@ -769,9 +1567,7 @@ class Integer {
 			* @throw std::bad_alloc on memory allocation error
 		*/
 		inline const Integer & operator--() {
-			this->add(*this,-1,0);
-			this->fix();
-			this->_modified = true;
+			this->decrement();
 
 			return *this;
 		}
@@ -785,11 +1581,7 @@ class Integer {
 		inline Integer operator--(int) {
 			Integer r(*this);
 
-			this->add(*this,-1,0);
-			this->fix();
-			this->_modified = true;
-
-			r._modified = true;
+			this->decrement();
 
 			return r;
 		}
@@ -804,6 +1596,7 @@ class Integer {
 
 		/** @brief Unnary negative operator.
 		 *	Returns Integer object containing negative value of the current Integer.
+		 *	Only the sign of the copy is flipped.
 		 *  @note Const method that does not modify the current Integer.
 		 *  @return Resulting current Integer
 		 * @throw std::bad_alloc on memory allocation error
@@ -848,9 +1641,11 @@ class Integer {
 		template <class INT_T,
 						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
 		inline Integer operator-(INT_T n) const {
-			Integer ret, opn(n);
-			ret.add(*this, opn, true);
-			ret._modified = true;
+			Integer ret(*this, SCALAR_MAX_WORDS + 1);
+			bool negative;
+			const unsigned __int128 m = scalar_magnitude(n, negative);
+
+			ret.add_scalar(m, !negative);
 
 			return ret;
 		}
@@ -874,9 +1669,12 @@ class Integer {
 		template <class INT_T,
 						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
 		friend inline Integer operator-(INT_T n, const Integer & i) {
-			Integer ret, opn(n);
-			ret.add(opn, i, true);
-			ret._modified = true;
+			Integer ret(i, SCALAR_MAX_WORDS + 1);
+			bool negative;
+			const unsigned __int128 m = scalar_magnitude(n, negative);
+
+			ret.multiply_scalar(1, true);
+			ret.add_scalar(m, negative);
 
 			return ret;
 		};
@@ -999,10 +1797,10 @@ class Integer {
 		template <class INT_T,
 						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
 		inline const Integer & operator-=(INT_T n) {
-			Integer opn(n);
+			bool negative;
+			const unsigned __int128 m = scalar_magnitude(n, negative);
 
-			this->add(*this, opn, true);
-			this->_modified = true;
+			this->add_scalar(m, !negative);
 
 			return *this;
 		}
@@ -1084,10 +1882,11 @@ class Integer {
 		template <class INT_T,
 						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
 		inline Integer operator*(INT_T n) const {
-			Integer ret, opn(n);
+			Integer ret(*this, SCALAR_MAX_WORDS + 1);
+			bool negative;
+			const unsigned __int128 m = scalar_magnitude(n, negative);
 
-			ret.multiply(*this, opn);
-			ret._modified = true;
+			ret.multiply_scalar(m, negative);
 
 			return ret;
 		}
@@ -1111,11 +1910,7 @@ class Integer {
 		template <class INT_T,
 						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
 		friend inline Integer operator*(INT_T n, const Integer & i) {
-			Integer ret, opn(n);
-			ret.multiply(opn, i);
-			ret._modified = true;
-
-			return ret;
+			return i * n;
 		};
 
 		/**	@brief String multiply operator.
@@ -1235,10 +2030,10 @@ class Integer {
 		template <class INT_T,
 						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
 		inline const Integer & operator*=(INT_T n) {
-			Integer opn(n);
+			bool negative;
+			const unsigned __int128 m = scalar_magnitude(n, negative);
 
-			this->multiply(*this, opn);
-			this->_modified = true;
+			this->multiply_scalar(m, negative);
 
 			return *this;
 		}
@@ -1867,7 +2662,7 @@ class Integer {
 		}
 
 		/** @brief Computes absolute value of the current Integer and stores it into
-			*	the current Integer.
+			*	the current Integer. Only the sign is cleared.
 			* @return Absolute value of current Integer
 			* @throw std::bad_alloc on memory allocation error
 		*/
@@ -1903,726 +2698,437 @@ class Integer {
 		*/
 		inline static Integer pow(const Integer & base, const Integer & exp) {
 			Integer ret(base);
-			ret.pow(exp);
-
-			return ret;
-		}
-
-		// Relational operators
-
-		/**	@brief Integer greater than operator
-			*	Determines whether current Integer value is greater than
-			*	the passed one.
-			*
-			*	@param n Integer that will be compared with the current Integer.
-			*
-			*	@return bool indicating whether current Integer value is greater
-			*	than the passed Integer value or not.
-			*	@note Const method that does not modify the current Integer.
-		*/
-		inline bool operator>(const Integer & n) const {return this->compare(n)>0;};
-
-		/**	@brief Integral type integer greater than operator
-			*	Determines whether current Integer value is greater than
-			*	a passed integral type integer.
-			*
-			*	@param n integral type integer that will be compared with the current Integer.
-			*
-			*	@return bool indicating whether current Integer value is greater
-			*	than the passed integral type integer or not.
-			*	@note Const method that does not modify the current Integer.
-			*	@note Following types can be passed as integral type bool, char,
-			*		char8_t (since C++20), char16_t, char32_t, wchar_t, short, int,
-			*		long, long long.
-		*/
-		template <class INT_T,
-						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
-		inline bool operator>(INT_T n) const {return this->compare(Integer(n)) > 0;};
-
-		/**	@brief Integral type integer greater than operator
-			*	Determines whether an integral type integer is greater than
-			*	Integer object value.
-			*
-			*	@param n integral type integer first term.
-			*	@param i Integer second term.
-			*
-			*	@return bool indicating whether integral type integer is greater than
-			*	Integer
-			*	@note Const method that does not modify the current Integer.
-			*	@note Following types can be passed as integral type bool, char,
-			*		char8_t (since C++20), char16_t, char32_t, wchar_t, short, int,
-			*		long, long long.
-			* @warning friend operator
-		*/
-		template <class INT_T,
-						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
-		friend inline bool operator>(INT_T n, const Integer & i) {
-			return Integer(n).compare(i) > 0;
-		}
-
-		/**	@brief string greater than operator
-			*	Determines whether current Integer value is greater than
-			*	a passed decimal integer written in a string.
-			*
-			*	@param n string containing integer that will be compared with the
-			*		current Integer.
-			*
-			*	@return bool indicating whether current Integer value is greater
-			*	than the passed string or not.
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
-		*/
-		inline bool operator>(const std::string & n) const {return this->compare(Integer(n)) > 0;};
-
-		/**	@brief C-string greater than operator
-			*	Determines whether current Integer value is greater than
-			*	a passed decimal integer written in a c-string (char array ended with \0).
-			*
-			*	@param n c-string containing integer that will be compared with the
-			*		current Integer.
-			*
-			*	@return bool indicating whether current Integer value is greater
-			*	than the passed string or not.
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
-		*/
-		inline bool operator>(const char * n) const {return this->compare(std::string(n)) > 0;};
-
-		/**	@brief String greater than operator
-			*	Determines whether a decimal integer written in a string is greater than
-			*	a Integer object value.
-			*
-			*	@param n string first term.
-			*	@param i Integer second term.
-			*
-			*	@return bool indicating whether string is greater than
-			*	Integer
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
-		*/
-		friend inline bool operator>(const std::string & n, const Integer & i) {
-			return Integer(n).compare(i) > 0;
-		}
-
-		/**	@brief C-string greater than operator
-			*	Determines whether a decimal integer written in a c-string (char array
-			*	ended with \0) is greater than a Integer object value.
-			*
-			*	@param n C-string first term.
-			*	@param i Integer second term.
-			*
-			*	@return bool indicating whether C-string is greater than
-			*	Integer
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
-		*/
-		friend inline bool operator>(const char * n, const Integer & i) {
-			return std::string(n) > i;
-		}
-
-		/**	@brief Integer greater than or equal operator
-			*	Determines whether current Integer value is greater than or equal than
-			*	the passed one.
-			*
-			*	@param n Integer that will be compared with the current Integer.
-			*
-			*	@return bool indicating whether current Integer value is greater
-			*	than or equal than the passed Integer value or not.
-			*	@note Const method that does not modify the current Integer.
-			*	@overload
-		*/
-		inline bool operator>=(const Integer & n) const {return this->compare(n) >= 0;};
-
-		/**	@brief Integral type integer greater than or equal operator
-			*	Determines whether current Integer value is greater than or equal than
-			*	a passed integral type integer.
-			*
-			*	@param n integral type integer that will be compared with the current Integer.
-			*
-			*	@return bool indicating whether current Integer value is greater
-			*	than or equal than the passed integral type integer or not.
-			*	@note Const method that does not modify the current Integer.
-			*	@note Following types can be passed as integral type bool, char,
-			*		char8_t (since C++20), char16_t, char32_t, wchar_t, short, int,
-			*		long, long long.
-			* @overload
-		*/
-		template <class INT_T,
-						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
-		inline bool operator>=(INT_T n) const {return this->compare(Integer(n)) >= 0;};
-
-		/**	@brief Integral type integer greater than or equal operator
-			*	Determines whether an integral type integer is greater than or equal than
-			*	a passed Integer.
-			*
-			*	@param n integral type integer first term.
-			*	@param i Integer second term.
-			*
-			*	@return bool indicating whether current Integer value is greater
-			*	than or equal than the passed integral type integer or not.
-			*	@note Const method that does not modify the current Integer.
-			*	@note Following types can be passed as integral type bool, char,
-			*		char8_t (since C++20), char16_t, char32_t, wchar_t, short, int,
-			*		long, long long.
-			* @overload
-			* @warning friend operator
-		*/
-		template <class INT_T,
-						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
-		friend inline bool operator>=(INT_T n, const Integer & i) {
-			return Integer(n).compare(i) >= 0;
-		}
-
-		/**	@brief String greater than or equal operator
-			*	Determines whether current Integer value is greater or equal than
-			*	the value of a decimal integer written in a string.
-			*
-			*	@param n string containing the integer that will be compared with the
-			*		current Integer.
-			*
-			*	@return bool indicating whether current Integer value is greater
-			*	or equal than the passed Integer value or not.
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
-		*/
-		inline bool operator>=(const std::string & n) const {return this->compare(Integer(n)) >= 0;};
-
-		/**	@brief C-string greater than or equal operator
-			*	Determines whether current Integer value is greater than or equal than
-			*	a passed decimal integer written in a c-string (char array ended with \0).
-			*
-			*	@param n c-string containing integer that will be compared with the current Integer.
-			*
-			*	@return bool indicating whether current Integer value is greater
-			*	than or equal than the passed string or not.
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
-		*/
-		inline bool operator>=(const char * n) const {return this->compare(std::string(n)) >= 0;};
-
-		/**	@brief String greater than or equal operator
-			*	Determines whether a decimal integer written in a string is greater than
-			*	or equal than a Integer object value.
-			*
-			*	@param n string first term.
-			*	@param i Integer second term.
-			*
-			*	@return bool indicating whether string is greater than or equal than
-			*	Integer
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @warning friend operator
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
-		*/
-		friend inline bool operator>=(const std::string & n, const Integer & i) {
-			return Integer(n).compare(i) >= 0;
-		}
-
-		/**	@brief C-string greater than or equal operator
-			*	Determines whether a decimal integer written in a c-string (char array
-			*	ended with \0) is greater than or equal than a Integer object value.
-			*
-			*	@param n C-string first term.
-			*	@param i Integer second term.
-			*
-			*	@return bool indicating whether C-string is greater than or equal than
-			*	Integer
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @warning friend operator
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
-		*/
-		friend inline bool operator>=(const char * n, const Integer & i) {
-			return std::string(n) >= i;
-		}
-
-		/**	@brief Integer less than operator
-			*	Determines whether current Integer value is less than
-			*	the passed one.
-			*
-			*	@param n Integer that will be compared with the current Integer.
-			*
-			*	@return bool indicating whether current Integer value is less
-			*	than the passed Integer value or not.
-			*	@note Const method that does not modify the current Integer.
-		*/
-		inline bool operator<(const Integer & n) const {return this->compare(n)<0;};
-
-		/**	@brief Integral type integer less than operator
-			*	Determines whether current Integer value is less than
-			*	a passed integral type integer.
-			*
-			*	@param n integral type integer that will be compared with the current Integer.
-			*
-			*	@return bool indicating whether current Integer value is less
-			*	than the passed integral type integer or not.
-			*	@note Const method that does not modify the current Integer.
-			*	@note Following types can be passed as integral type bool, char,
-			*		char8_t (since C++20), char16_t, char32_t, wchar_t, short, int,
-			*		long, long long.
-		*/
-		template <class INT_T,
-						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
-		inline bool operator<(INT_T n) const {return this->compare(Integer(n)) < 0;};
-
-		/**	@brief Integral type integer less than operator
-			*	Determines whether an integral type integer is less than
-			*	Integer object value.
-			*
-			*	@param n integral type integer first term to be compared with second term.
-			*	@param i Integer second term.
-			*
-			*	@return bool indicating whether integral type integer is less than
-			*	Integer
-			*	@note Const method that does not modify the current Integer.
-			*	@note Following types can be passed as integral type bool, char,
-			*		char8_t (since C++20), char16_t, char32_t, wchar_t, short, int,
-			*		long, long long.
-			* @warning friend operator
-		*/
-		template <class INT_T,
-						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
-		friend inline bool operator<(INT_T n, const Integer & i) {
-			return Integer(n).compare(i) < 0;
+			ret.pow(exp);
+
+			return ret;
 		}
 
-		/**	@brief string less than operator
-			*	Determines whether current Integer value is less than
-			*	a passed decimal integer written in a string.
-			*
-			*	@param n string containing integer that will be compared with the current Integer.
+		/** @brief Greatest common divisor. Operands are reduced through
+			*	Lehmer's algorithm, whose steps are determined by the 62 most
+			*	significant bits of the operands, and finished by binary GCD once they
+			*	fit in a native word. Operands above the hgcd threshold are reduced
+			*	beforehand through half-GCD.
 			*
-			*	@return bool indicating whether current Integer value is less
-			*	than the passed string or not.
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
+			* @param a First operand.
+			*	@param b Second operand.
+ 		 	* @throw std::bad_alloc on memory allocation error
+			* @return gcd(|a|, |b|), being gcd(0, 0) = 0.
 		*/
-		inline bool operator<(const std::string & n) const {return this->compare(Integer(n)) < 0;};
+		static Integer gcd(const Integer & a, const Integer & b);
 
-		/**	@brief C-string less than operator
-			*	Determines whether current Integer value is less than
-			*	a passed decimal integer written in a c-string (char array ended with \0).
-			*
-			*	@param n c-string containing integer that will be compared with the current Integer.
+		/** @brief Least common multiple.
 			*
-			*	@return bool indicating whether current Integer value is less
-			*	than the passed string or not.
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
+			* @param a First operand.
+			*	@param b Second operand.
+ 		 	* @throw std::bad_alloc on memory allocation error
+			* @return lcm(|a|, |b|), being 0 when any operand is 0.
 		*/
-		inline bool operator<(const char * n) const {return this->compare(std::string(n)) < 0;};
+		static Integer lcm(const Integer & a, const Integer & b);
 
-		/**	@brief String less than operator
-			*	Determines whether a decimal integer written in a string is less than
-			*	a Integer object value.
-			*
-			*	@param n string containing decimal integer as first term.
-			*	@param i Integer second term.
+		/** @brief Extended greatest common divisor. Computes gcd(a, b) and the
+			*	Bezout coefficients s and t, s*a + t*b = gcd(a, b), through the same
+			*	reductions as gcd with their cofactors tracked.
 			*
-			*	@return bool indicating whether string is less than
-			*	Integer
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
+			* @param a First operand.
+			*	@param b Second operand.
+			*	@param s Output coefficient of a, the one of least absolute value:
+			*		|s| <= |b| / (2*gcd(a, b)) unless b is 0.
+			*	@param t Output coefficient of b, (gcd(a, b) - s*a) / b.
+ 		 	* @throw std::bad_alloc on memory allocation error
+			* @return gcd(|a|, |b|), being gcd(0, 0) = 0 with s = t = 0.
 		*/
-		friend inline bool operator<(const std::string & n, const Integer & i) {
-			return Integer(n).compare(i) < 0;
-		}
+		static Integer gcdext(const Integer & a, const Integer & b, Integer & s, Integer & t);
 
-		/**	@brief C-string less than operator
-			*	Determines whether a decimal integer written in a c-string (char array
-			*	ended with \0) is less than a Integer object value.
-			*
-			*	@param n C-string containing decimal integer as first term.
-			*	@param i Integer second term.
-			*
-			*	@return bool indicating whether C-string is less than
-			*	Integer
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
+		/** @brief Extended greatest common divisor computing only the Bezout
+			*	coefficient of a, which saves the division giving the one of b.
+			*	@see gcdext(const Integer &, const Integer &, Integer &, Integer &)
 		*/
-		friend inline bool operator<(const char * n, const Integer & i) {
-			return std::string(n) < i;
-		}
+		static Integer gcdext(const Integer & a, const Integer & b, Integer & s);
 
-		/**	@brief Integer less than or equal operator
-			*	Determines whether current Integer value is less than or equal than
-			*	the passed one.
-			*
-			*	@param n Integer that will be compared with the current Integer.
+		/** @brief Modular inverse. Computes x in [0, m) such that a*x mod m = 1,
+			*	through the Bezout coefficient of a and m.
 			*
-			*	@return bool indicating whether current Integer value is less
-			*	than or equal than the passed Integer value or not.
-			*	@note Const method that does not modify the current Integer.
-			*	@overload
+			* @param a Value to invert. Negative values are reduced to [0, m).
+			*	@param m Modulus.
+			* @pre m must be greater than 0
+ 		 	* @throw std::bad_alloc on memory allocation error
+			* @throw std::invalid_argument when m is negative or a has no inverse,
+			*		that is when a is not coprime with m.
+			* @throw zero_division_error when m is zero
+			* @return The inverse of a modulo m, being 0 for m = 1.
+		*/
+		static Integer invert(const Integer & a, const Integer & m);
+
+		/** @brief Batch modular inverse. Replaces every value by its inverse
+			*	modulo m through Montgomery's simultaneous inversion: a single
+			*	inversion of the product of the values, plus 3(n-1) modular
+			*	multiplications on prefix products. Long batches are split into
+			*	chunks across threads, whose products are inverted together.
+			*
+			* @param values Values to invert, replaced by their inverses in [0, m),
+			*		being 0 for m = 1. Negative values are reduced to [0, m).
+			*	@param m Modulus.
+			* @pre m must be greater than 0
+ 		 	* @throw std::bad_alloc on memory allocation error
+			* @throw std::invalid_argument when m is negative or any value has no
+			*		inverse, in which case values are left unchanged.
+			* @throw zero_division_error when m is zero
 		*/
-		inline bool operator<=(const Integer & n) const {return this->compare(n) <= 0;};
+		static void invert_batch(std::span<Integer> values, const Integer & m);
 
-		/**	@brief Integral type integer less than or equal operator
-			*	Determines whether current Integer value is less than or equal than
-			*	a passed integral type integer.
-			*
-			*	@param n integral type integer that will be compared with the current Integer.
+		/** @brief Modular power. Computes base^exp mod mod keeping the intermediate
+			*	values reduced, through Montgomery multiplication on odd moduli and
+			*	Barrett reduction on even ones, with sliding window exponentiation.
 			*
-			*	@return bool indicating whether current Integer value is greater
-			*	than or equal than the passed integral type integer or not.
-			*	@note Const method that does not modify the current Integer.
-			*	@note Following types can be passed as integral type bool, char,
-			*		char8_t (since C++20), char16_t, char32_t, wchar_t, short, int,
-			*		long, long long.
-			* @overload
+			* @param base Base of the power. Negative bases are reduced to [0, mod).
+			*	@param exp Exponent of the power.
+			*	@param mod Modulus.
+			* @pre exp must be positive and mod greater than 0
+ 		 	* @throw std::bad_alloc on memory allocation error
+ 		 	* @throw std::invalid_argument when exp or mod are negative.
+			* @throw zero_division_error when mod is zero
+			* @return The result of the power, in [0, mod).
+			* @see MontgomeryContext and BarrettContext for many operations modulo
+			*	the same modulus.
 		*/
-		template <class INT_T,
-						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
-		inline bool operator<=(INT_T n) const {return this->compare(Integer(n)) <= 0;};
+		static Integer powmod(const Integer & base, const Integer & exp, const Integer & mod);
 
-		/**	@brief Integral type integer less than or equal operator
-			*	Determines whether an integral type integer is less than or equal than
-			*	a passed Integer.
+		/** @brief Integer square root through Karatsuba square root, that is
+			*	in the time of a few multiplications of the operand size.
 			*
-			*	@param n integral type integer first comparison term.
-			*	@param i Integer second comparison term.
-			*
-			*	@return bool indicating whether current Integer value is less
-			*	than or equal than the passed integral type integer or not.
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			*	@note Following types can be passed as integral type bool, char,
-			*		char8_t (since C++20), char16_t, char32_t, wchar_t, short, int,
-			*		long, long long.
-			* @warning friend operator
+			* @param n Radicand.
+			* @pre n must be positive or 0
+ 		 	* @throw std::bad_alloc on memory allocation error
+			* @throw std::invalid_argument when n is negative.
+			* @return floor(sqrt(n))
 		*/
-		template <class INT_T,
-						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
-		friend inline bool operator<=(INT_T n, const Integer & i) {
-			return Integer(n).compare(i) <= 0;
-		}
+		static Integer sqrt(const Integer & n);
 
-		/**	@brief String less than or equal operator
-			*	Determines whether current Integer value is less or equal than
-			*	the value of a decimal integer written in a string.
+		/** @brief Integer square root with remainder.
 			*
-			*	@param n string containing the integer that will be compared with the
-			*		current Integer.
+			* @param n Radicand.
+			*	@param r Output remainder, n - sqrt(n)^2
+			* @pre n must be positive or 0
+ 		 	* @throw std::bad_alloc on memory allocation error
+			* @throw std::invalid_argument when n is negative.
+			* @return floor(sqrt(n))
+			*	@see sqrt
+		*/
+		static Integer sqrtrem(const Integer & n, Integer & r);
+
+		/** @brief Determines whether n is the square of an Integer. Most non
+			*	squares are rejected through their residues modulo 64, 63, 65 and 11,
+			*	which must be quadratic residues, before the root is computed.
 			*
-			*	@return bool indicating whether current Integer value is less
-			*	or equal than the passed Integer value or not.
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
+			* @param n Value to check.
+ 		 	* @throw std::bad_alloc on memory allocation error
+			* @return true if n is a perfect square, being 0 and 1 so, or false
+			*		otherwise, negative values included.
 		*/
-		inline bool operator<=(const std::string & n) const {return this->compare(Integer(n)) <= 0;};
+		static bool is_perfect_square(const Integer & n);
 
-		/**	@brief C-string less than or equal operator
-			*	Determines whether current Integer value is less than or equal than
-			*	a passed decimal integer written in a c-string (char array ended with \0).
+		/** @brief Integer k-th root through Newton's iteration with precision
+			*	doubling: the root of the most significant bits gives an estimate of
+			*	half the bits of the root, which few iterations on the whole value
+			*	correct, so the early iterations work on short values.
 			*
-			*	@param n c-string containing integer that will be compared with the current Integer.
+			* @param n Radicand. Negative values are only accepted for odd k.
+			*	@param k Root index.
+			* @pre k must be greater than 0, and odd when n is negative
+ 		 	* @throw std::bad_alloc on memory allocation error
+			* @throw std::invalid_argument when k is 0 or n is negative for an even k.
+			* @return The k-th root of n truncated towards 0, floor(n^(1/k)) when n
+			*		is positive.
+		*/
+		static Integer iroot(const Integer & n, size_t k);
+
+		/** @brief Determines whether n = a^b for some Integer a and b >= 2. Only
+			*	prime exponents up to the number of bits of n are tried, those not
+			*	dividing the number of trailing zeros of n are discarded, and the
+			*	rest must pass two power residue filters modulo small primes before
+			*	the root is computed.
 			*
-			*	@return bool indicating whether current Integer value is less
-			*	than or equal than the passed string or not.
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
+			* @param n Value to check.
+ 		 	* @throw std::bad_alloc on memory allocation error
+			* @return true if n is a perfect power, being 0, 1 and -1 so, or false
+			*		otherwise. Negative values need an odd exponent.
 		*/
-		inline bool operator<=(const char * n) const {return this->compare(std::string(n)) <= 0;};
+		static bool is_perfect_power(const Integer & n);
 
-		/**	@brief String less than or equal operator
-			*	Determines whether a decimal integer written in a string is less than
-			*	or equal than a Integer object value.
+		/** @brief Low short product. Computes the n less significant words of the
+			*	product a*b, that is a*b mod 2^(31*n), skipping the partial products
+			*	falling into the higher words.
 			*
-			*	@param n string containing the decimal integer as first term.
-			*	@param i Integer second term.
+			* @param a First operand.
+			*	@param b Second operand.
+			*	@param n Number of words to compute.
+			* @pre a and b must be positive.
+			* @throw std::bad_alloc on memory allocation error
+			* @throw std::invalid_argument when a or b are negative.
+			* @return a*b mod 2^(31*n)
+			*	@note Schoolbook algorithm is used below the short_product threshold
+			*		words and Mulders' Karatsuba based short product above.
+		*/
+		static Integer mul_low(const Integer & a, const Integer & b, size_t n);
+
+		/** @brief High short product. Approximates the n most significant words
+			*	of the 2n words product of a and b, that is a*b / 2^(31*n), skipping
+			*	most of the partial products falling into the lower words.
 			*
-			*	@return bool indicating whether string is less than or equal than
-			*	Integer
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @warning friend operator
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
+			* @param a First operand having n words as max.
+			*	@param b Second operand having n words as max.
+			*	@param n Number of words of the operands.
+			* @pre a and b must be positive and lower than 2^(31*n).
+			* @throw std::bad_alloc on memory allocation error
+			* @throw std::invalid_argument when a or b are negative or exceed n words.
+			* @return h such that floor(a*b / 2^(31*n)) - 2n <= h <= floor(a*b / 2^(31*n))
+			*	@note Schoolbook algorithm is used below the short_product threshold
+			*		words and Mulders' Karatsuba based short product above.
 		*/
-		friend inline bool operator<=(const std::string & n, const Integer & i) {
-			return Integer(n).compare(i) <= 0;
-		}
+		static Integer mul_high(const Integer & a, const Integer & b, size_t n);
 
-		/**	@brief C-string less than or equal operator
-			*	Determines whether a decimal integer written in a c-string (char array
-			*	ended with \0) is less than or equal than a Integer object value.
+		/** @brief Middle product. Adds the partial products a_i * b_j whose words
+			*	indexes satisfy n-1 <= i+j <= 2n-2, that is the n middle words of the
+			*	product of a (2n-1 words) by b (n words) without the carries coming
+			*	from the lower words. Used on Newton iterations where the low words of a
+			*	product are already known.
 			*
-			*	@param n C-string first term to be compared with second term.
-			*	@param i Integer second term.
+			*	Result is sum(a_i * b_j * 2^(31*(i+j-n+1))) for the above indexes.
 			*
-			*	@return bool indicating whether C-string is less than or equal than
-			*	Integer
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @warning friend operator
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
+			* @param a First operand having 2n-1 words as max.
+			*	@param b Second operand having n words as max.
+			*	@param n Number of words of b.
+			* @pre a and b must be positive, a lower than 2^(31*(2n-1)) and b lower
+			*		than 2^(31*n).
+			* @throw std::bad_alloc on memory allocation error
+			* @throw std::invalid_argument when a or b are negative or exceed their
+			*		number of words.
+			* @return Middle product of a and b.
+			*	@note Schoolbook algorithm is used below the short_product threshold
+			*		words and transposed Karatsuba (Hanrot, Quercia, Zimmermann) above.
 		*/
-		friend inline bool operator<=(const char * n, const Integer & i) {
-			return std::string(n) <= i;
-		}
+		static Integer mul_mid(const Integer & a, const Integer & b, size_t n);
 
-		/**	@brief Integer equal than operator
-			*	Determines whether current Integer value is equal than
-			*	the passed one.
+		/** @brief Multiplies many independent pairs of Integers, storing
+			*	a[i]*b[i] into out[i].
 			*
-			*	@param n Integer that will be compared with the current Integer.
+			*	Pairs up to BATCH_MULTIPLY_MAX_WORDS words are grouped by size and
+			*	multiplied several at once, one pair per SIMD lane (AVX-512 or AVX2,
+			*	selected at runtime, with a portable fallback). Larger pairs are
+			*	multiplied one by one. Results reuse the storage already held by out.
 			*
-			*	@return bool indicating whether current Integer value is equal
-			*	than the passed Integer value or not.
-			*	@note Const method that does not modify the current Integer.
+			* @param a First operands.
+			*	@param b Second operands.
+			*	@param out Results.
+			* @pre a, b and out must have the same size and out must not overlap a
+			*		or b.
+			* @throw std::bad_alloc on memory allocation error
+			* @throw std::invalid_argument when a, b and out sizes differ.
 		*/
-		inline bool operator==(const Integer & n) const {return this->compare(n) == 0;};
+		static void multiply_batch(std::span<const Integer> a, std::span<const Integer> b,
+																std::span<Integer> out);
 
-		/**	@brief Integral type integer equal than operator
-			*	Determines whether current Integer value is equal than
-			*	a passed integral type integer.
+		/** @brief Computes the product of every Integer of a sequence.
 			*
-			*	@param n integral type integer that will be compared with the current Integer.
+			*	Factors are multiplied pairwise on a balanced product tree, so the
+			*	large products are computed between operands of similar size instead
+			*	of accumulating small factors into a growing result.
 			*
-			*	@return bool indicating whether current Integer value is equal
-			*	than the passed integral type integer or not.
-			*	@note Const method that does not modify the current Integer.
-			*	@note Following types can be passed as integral type bool, char,
-			*		char8_t (since C++20), char16_t, char32_t, wchar_t, short, int,
-			*		long, long long.
+			* @param factors Factors to be multiplied.
+			* @throw std::bad_alloc on memory allocation error
+			* @return Product of the factors, 1 when factors is empty.
+			*	@see ProductTree
 		*/
-		template <class INT_T,
-						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
-		inline bool operator==(INT_T n) const {return this->compare(Integer(n)) == 0;};
+		static Integer product(std::span<const Integer> factors);
 
-		/**	@brief Integral type integer equal than operator
-			*	Determines whether integral type integer is equal than
-			*	Integer object value.
-			*
-			*	@param n integral type integer first term.
-			*	@param i Integer second term.
+		/** @brief Fused multiply-add. Computes acc += a*b accumulating the product
+			*	straight into the words of acc, without building a product Integer.
 			*
-			*	@return bool indicating whether integral type integer is equal than
-			*	Integer
-			*	@note Const method that does not modify the current Integer.
-			*	@note Following types can be passed as integral type bool, char,
-			*		char8_t (since C++20), char16_t, char32_t, wchar_t, short, int,
-			*		long, long long.
-			* @warning friend operator
+			* @param acc Accumulator. It may be a or b.
+			* @param a First operand.
+			*	@param b Second operand.
+			* @throw std::bad_alloc on memory allocation error
 		*/
-		template <class INT_T,
-						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
-		friend inline bool operator==(INT_T n, const Integer & i) {
-			return Integer(n).compare(i) == 0;
+		inline static void addmul(Integer & acc, const Integer & a, const Integer & b) {
+			acc.accumulate_product(a, b, false);
 		}
 
-		/**	@brief string equal than operator
-			*	Determines whether current Integer value is equal than
-			*	a passed decimal integer written in a string.
-			*
-			*	@param n string containing integer that will be compared with the current Integer.
+		/** @brief Fused multiply-subtract. Computes acc -= a*b accumulating the
+			*	product straight into the words of acc, without building a product
+			*	Integer.
 			*
-			*	@return bool indicating whether current Integer value is equal
-			*	than the passed string or not.
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
+			* @param acc Accumulator. It may be a or b.
+			* @param a First operand.
+			*	@param b Second operand.
+			* @throw std::bad_alloc on memory allocation error
 		*/
-		inline bool operator==(const std::string & n) const {return this->compare(Integer(n)) == 0;};
+		inline static void submul(Integer & acc, const Integer & a, const Integer & b) {
+			acc.accumulate_product(a, b, true);
+		}
 
-		/**	@brief C-string equal than operator
-			*	Determines whether current Integer value is equal than
-			*	a passed decimal integer written in a c-string (char array ended with \0).
+		/** @brief Fused multiply-add by a scalar. Computes acc += a*b on a single
+			*	pass over the words of a and acc.
 			*
-			*	@param n c-string containing integer that will be compared with the current Integer.
-			*
-			*	@return bool indicating whether current Integer value is equal
-			*	than the passed string or not.
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
+			* @param acc Accumulator. It may be a.
+			* @param a First operand.
+			*	@param b Scalar operand.
+			* @throw std::bad_alloc on memory allocation error
 		*/
-		inline bool operator==(const char * n) const {return this->compare(std::string(n)) == 0;};
+		inline static void addmul_ui(Integer & acc, const Integer & a, uint64_t b) {
+			acc.accumulate_scalar_product(a, b, false);
+		}
 
-		/**	@brief String equal than operator
-			*	Determines whether a decimal integer written in a string is equal than
-			*	a Integer object value.
-			*
-			*	@param n string containing integer as first term.
-			*	@param i Integer second term.
+		/** @brief Fused multiply-subtract by a scalar. Computes acc -= a*b on a
+			*	single pass over the words of a and acc.
 			*
-			*	@return bool indicating whether string is equal than
-			*	Integer
-			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @warning friend operator
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
+			* @param acc Accumulator. It may be a.
+			* @param a First operand.
+			*	@param b Scalar operand.
+			* @throw std::bad_alloc on memory allocation error
 		*/
-		friend inline bool operator==(const std::string & n, const Integer & i) {
-			return Integer(n).compare(i) == 0;
+		inline static void submul_ui(Integer & acc, const Integer & a, uint64_t b) {
+			acc.accumulate_scalar_product(a, b, true);
 		}
 
-		/**	@brief C-string equal than operator
-			*	Determines whether a decimal integer written in a c-string (char array
-			*	ended with \0) is equal than a Integer object value.
+		// Relational operators
+
+		/**	@brief Integer three-way comparison operator
+			*	Compares current Integer value with the passed one. <, <=, > and >=
+			*	operators are derived from it.
 			*
-			*	@param n C-string containing integer as first term.
-			*	@param i Integer second term.
+			*	@param n Integer that will be compared with the current Integer.
 			*
-			*	@return bool indicating whether C-string is equal than
-			*	Integer
+			*	@return std::strong_ordering of the current Integer with respect to n.
 			*	@note Const method that does not modify the current Integer.
-			* @overload
-			* @warning friend operator
-			* @throw std::invalid_argument when input string contains a
-			*	non-valid integer decimal character.
 		*/
-		friend inline bool operator==(const char * n, const Integer & i) {
-			return std::string(n) == i;
-		}
+		inline std::strong_ordering operator<=>(const Integer & n) const {
+			return this->compare(n) <=> 0;
+		};
 
-		/**	@brief Integer not equal than operator
-			*	Determines whether current Integer value is not equal than
-			*	the passed one.
+		/**	@brief Integer equal to operator
+			*	Determines whether current Integer value is equal to the passed one.
+			*	!= operator is derived from it.
 			*
 			*	@param n Integer that will be compared with the current Integer.
 			*
-			*	@return bool indicating whether current Integer value is not equal
-			*	than the passed Integer value or not.
+			*	@return bool indicating whether both values are equal or not.
 			*	@note Const method that does not modify the current Integer.
 		*/
-		inline bool operator!=(const Integer & n) const {return this->compare(n) != 0;};
+		inline bool operator==(const Integer & n) const {return this->compare(n) == 0;};
 
-		/**	@brief Integral type integer not equal than operator
-			*	Determines whether current Integer value is not equal than
-			*	a passed integral type integer.
+		/**	@brief Integral type integer three-way comparison operator
+			*	Compares current Integer value with a passed integral type integer,
+			*	reading the most significant words only and without building an
+			*	Integer. <, <=, > and >= operators on both operands orders are
+			*	derived from it.
 			*
 			*	@param n integral type integer that will be compared with the current Integer.
 			*
-			*	@return bool indicating whether current Integer value is not equal
-			*	than the passed integral type integer or not.
+			*	@return std::strong_ordering of the current Integer with respect to n.
 			*	@note Const method that does not modify the current Integer.
 			*	@note Following types can be passed as integral type bool, char,
 			*		char8_t (since C++20), char16_t, char32_t, wchar_t, short, int,
-			*		long, long long.
+			*		long, long long and their unsigned variants.
 		*/
 		template <class INT_T,
 						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
-		inline bool operator!=(INT_T n) const {return this->compare(Integer(n)) != 0;};
+		inline std::strong_ordering operator<=>(INT_T n) const {
+			bool negative;
+			const unsigned __int128 m = scalar_magnitude(n, negative);
+
+			return this->compare_scalar(m, negative) <=> 0;
+		};
 
-		/**	@brief Integral type integer not equal than operator
-			*	Determines whether integral type integer is not equal than
-			*	Integer object value.
+		/**	@brief Integral type integer equal to operator
+			*	Determines whether current Integer value is equal to a passed
+			*	integral type integer without building an Integer. != operator on
+			*	both operands orders is derived from it.
 			*
-			*	@param n integral type integer first term.
-			*	@param i Integer second term.
+			*	@param n integral type integer that will be compared with the current Integer.
 			*
-			*	@return bool indicating whether integral type integer is not equal than
-			*	Integer
+			*	@return bool indicating whether both values are equal or not.
 			*	@note Const method that does not modify the current Integer.
-			* @warning friend operator
 			*	@note Following types can be passed as integral type bool, char,
 			*		char8_t (since C++20), char16_t, char32_t, wchar_t, short, int,
-			*		long, long long.
+			*		long, long long and their unsigned variants.
 		*/
 		template <class INT_T,
 						class = typename std::enable_if<std::is_integral<INT_T>::value>::type>
-		friend inline bool operator!=(INT_T n, const Integer & i) {
-			return Integer(n).compare(i) != 0;
-		}
+		inline bool operator==(INT_T n) const {
+			bool negative;
+			const unsigned __int128 m = scalar_magnitude(n, negative);
+
+			return this->compare_scalar(m, negative) == 0;
+		};
 
-		/**	@brief string not equal than operator
-			*	Determines whether current Integer value is not equal than
-			*	a passed decimal integer written in a string.
+		/**	@brief string three-way comparison operator
+			*	Compares current Integer value with a decimal integer written in a
+			*	string. <, <=, > and >= operators on both operands orders are derived
+			*	from it.
 			*
-			*	@param n string containing integer that will be compared with the current Integer.
+			*	@param n string containing integer that will be compared with the
+			*		current Integer.
 			*
-			*	@return bool indicating whether current Integer value is not equal
-			*	than the passed string or not.
+			*	@return std::strong_ordering of the current Integer with respect to n.
 			*	@note Const method that does not modify the current Integer.
 			* @overload
 			* @throw std::invalid_argument when input string contains a
 			*	non-valid integer decimal character.
+			*	@see compare_string
 		*/
-		inline bool operator!=(const std::string & n) const {return this->compare(Integer(n)) != 0;};
+		inline std::strong_ordering operator<=>(const std::string & n) const {
+			return this->compare_string(n) <=> 0;
+		};
 
-		/**	@brief C-string not equal than operator
-			*	Determines whether current Integer value is not equal than
-			*	a passed decimal integer written in a c-string (char array ended with \0).
+		/**	@brief string equal to operator
+			*	Determines whether current Integer value is equal to a decimal integer
+			*	written in a string. != operator on both operands orders is derived
+			*	from it.
 			*
-			*	@param n c-string containing integer that will be compared with the current Integer.
+			*	@param n string containing integer that will be compared with the
+			*		current Integer.
 			*
-			*	@return bool indicating whether current Integer value is not equal
-			*	than the passed string or not.
+			*	@return bool indicating whether both values are equal or not.
 			*	@note Const method that does not modify the current Integer.
 			* @overload
 			* @throw std::invalid_argument when input string contains a
 			*	non-valid integer decimal character.
 		*/
-		inline bool operator!=(const char * n) const {return this->compare(std::string(n)) != 0;};
+		inline bool operator==(const std::string & n) const {return this->compare_string(n) == 0;};
 
-		/**	@brief String not equal than operator
-			*	Determines whether a decimal integer written in a string is not equal than
-			*	a Integer object value.
+		/**	@brief C-string three-way comparison operator
+			*	Compares current Integer value with a decimal integer written in a
+			*	C-string. <, <=, > and >= operators on both operands orders are
+			*	derived from it.
 			*
-			*	@param n string containing decimal integer as first term.
-			*	@param i Integer second term.
+			*	@param n C-string containing integer that will be compared with the
+			*		current Integer.
 			*
-			*	@return bool indicating whether string is not equal than
-			*	Integer
+			*	@return std::strong_ordering of the current Integer with respect to n.
 			*	@note Const method that does not modify the current Integer.
 			* @overload
-			* @warning friend operator
 			* @throw std::invalid_argument when input string contains a
 			*	non-valid integer decimal character.
 		*/
-		friend inline bool operator!=(const std::string & n, const Integer & i) {
-			return Integer(n).compare(i) != 0;
-		}
+		inline std::strong_ordering operator<=>(const char * n) const {
+			return this->compare_string(n) <=> 0;
+		};
 
-		/**	@brief C-string not equal than operator
-			*	Determines whether a decimal integer written in a c-string (char array
-			*	ended with \0) is not equal than a Integer object value.
+		/**	@brief C-string equal to operator
+			*	Determines whether current Integer value is equal to a decimal integer
+			*	written in a C-string. != operator on both operands orders is derived
+			*	from it.
 			*
-			*	@param n C-string first term.
-			*	@param i Integer second term.
+			*	@param n C-string containing integer that will be compared with the
+			*		current Integer.
 			*
-			*	@return bool indicating whether C-string is not equal than
-			*	Integer
+			*	@return bool indicating whether both values are equal or not.
 			*	@note Const method that does not modify the current Integer.
 			* @overload
-			* @warning friend operator
 			* @throw std::invalid_argument when input string contains a
 			*	non-valid integer decimal character.
 		*/
-		friend inline bool operator!=(const char * n, const Integer & i) {
-			return std::string(n) != i;
-		}
+		inline bool operator==(const char * n) const {return this->compare_string(n) == 0;};
 
 		// Logic operators
 
@@ -3334,6 +3840,86 @@ class Integer {
 			Integer::_random_engine = random_engine;
 		}
 
+		/**
+			* @brief Sets the max number of threads used by parallel algorithms for
+			*	all Integer objects. 1 disables multithreading.
+			*	@param n_threads Max number of threads. 0 is handled as 1.
+		*/
+		inline static void set_n_threads(size_t n_threads) {
+			Integer::_n_threads = n_threads > 0? n_threads : 1;
+		}
+
+		/**
+			* @brief Sets the factor applied to the words capacity of every Integer
+			*	when it is exceeded. 1 grows the capacity to the exact size required.
+			*	@param growth_factor Growth factor
+			* @throw std::invalid_argument if growth_factor is lower than 1 or not
+			*	finite
+		*/
+		inline static void set_growth_factor(double growth_factor) {
+			if (!(growth_factor >= 1) || !std::isfinite(growth_factor))
+				throw std::invalid_argument("Growth factor must be finite and at least 1");
+
+			Integer::_growth_factor = growth_factor;
+		}
+
+		/**
+			* @brief Reserves capacity for values up to n_bits bits, so the current
+			*	Integer does not reallocate its words while it grows up to that size.
+			*	@param n_bits Number of bits to reserve
+			* @throw std::bad_alloc on memory allocation error
+		*/
+		inline void reserve(size_t n_bits) {
+			this->_words.reserve(n_bits / N_BITS_PER_WORD + 1);
+		}
+
+		/**
+			* @brief Releases the capacity not used by the current value, i.e after
+			*	a transient big value was reduced.
+			* @throw std::bad_alloc on memory allocation error
+		*/
+		inline void shrink_to_fit() {
+			this->_words.shrink_to_fit();
+			this->_str_fmt_cache.shrink_to_fit();
+		}
+
+		/**
+			* @brief Turns the current Integer words into an immutable reference counted
+			*	buffer, so copies of the Integer share them in constant time. Words are
+			*	cloned by the first copy modifying its value (copy-on-write), while the
+			*	others keep sharing them. Concurrent readers of the copies are safe.
+			* @throw std::bad_alloc on memory allocation error
+		*/
+		inline void share() {
+			this->_words.share();
+		}
+
+		/**
+			* @brief Sets the algorithm thresholds for all Integer objects.
+			*	@param thresholds Thresholds to be applied.
+			* @throw std::invalid_argument when a threshold is out of range:
+			*		karatsuba_multiply < 2, ntt_multiply <= karatsuba_multiply,
+			*		short_product < 4, hgcd < 4 or ntt_block not being a power of 2 >= 2.
+			*	@warning Not thread safe, thresholds must not be changed while other
+			*		threads operate on Integer objects.
+		*/
+		static void set_thresholds(const Thresholds & thresholds);
+
+		/**
+			* @brief Reads the algorithm thresholds from a file generated by the
+			*	tune_integer tool and applies them to all Integer objects.
+			*
+			*	Each line of the file has a threshold name followed by its value
+			*	(i.e "ntt_multiply 700"). Empty lines and lines beginning by '#' are
+			*	skipped. Thresholds not found on the file keep their current values.
+			*
+			*	@param filename Path to the thresholds file.
+			* @throw std::runtime_error when the file cannot be read.
+			* @throw std::invalid_argument on unknown threshold names, non-valid
+			*		values or thresholds out of range.
+		*/
+		static void load_thresholds(const std::string & filename);
+
 		/////	Destructor	/////
 
 		/**	@brief Destructor
@@ -3343,6 +3929,125 @@ class Integer {
 
 };
 
+/////	Modular Integer	/////
+
+/**
+	* @brief Integer modulo a fixed modulus m of n words, for modular arithmetic
+	*	inner loops.
+	*
+	*	Values are kept reduced on n words and share an immutable precomputed
+	*	context of the modulus: Montgomery context on odd moduli, where values
+	*	are kept in Montgomery form, and Barrett context on even ones. Operations
+	*	work on the n words with no normalization and no general division, but
+	*	inverse, computed by Integer::invert. Values are converted back into
+	*	Integer on demand.
+	*
+	*	Operations between ModIntegers require them to have the same modulus.
+*/
+class ModInteger {
+	public:
+
+		/**	@brief Constructs the value 0 modulo mod, precomputing the context of
+			*	the modulus. Values sharing the modulus should be constructed from
+			*	this one, so they share the context.
+			*
+			* @param mod Modulus greater than 1.
+			* @throw std::bad_alloc on memory allocation error
+			* @throw std::invalid_argument when mod is lower than 2.
+		*/
+		explicit ModInteger(const Integer & mod);
+
+		/**	@brief Constructs value modulo mod, precomputing the context of the
+			*	modulus.
+			*
+			* @param value Value. It is reduced to [0, mod).
+			* @param mod Modulus greater than 1.
+			* @throw std::bad_alloc on memory allocation error
+			* @throw std::invalid_argument when mod is lower than 2.
+		*/
+		ModInteger(const Integer & value, const Integer & mod);
+
+		/**	@brief Constructs value modulo the modulus of other, sharing its context.
+			*
+			* @param value Value. It is reduced to [0, mod).
+			* @param other ModInteger whose modulus is used.
+			* @throw std::bad_alloc on memory allocation error
+		*/
+		ModInteger(const Integer & value, const ModInteger & other);
+
+		/**	@brief Converts the current ModInteger into an Integer in [0, mod).
+			* @throw std::bad_alloc on memory allocation error
+		*/
+		Integer value() const;
+
+		/**	@brief Gets the modulus.
+			* @throw std::bad_alloc on memory allocation error
+		*/
+		Integer modulus() const;
+
+		/**	@brief Adds n to the current ModInteger.
+			* @throw std::invalid_argument when moduli are different.
+		*/
+		ModInteger & operator+=(const ModInteger & n);
+
+		/**	@brief Subtracts n from the current ModInteger.
+			* @throw std::invalid_argument when moduli are different.
+		*/
+		ModInteger & operator-=(const ModInteger & n);
+
+		/**	@brief Multiplies the current ModInteger by n.
+			* @throw std::invalid_argument when moduli are different.
+		*/
+		ModInteger & operator*=(const ModInteger & n);
+
+		inline ModInteger operator+(const ModInteger & n) const {ModInteger r(*this); r += n; return r;};
+		inline ModInteger operator-(const ModInteger & n) const {ModInteger r(*this); r -= n; return r;};
+		inline ModInteger operator*(const ModInteger & n) const {ModInteger r(*this); r *= n; return r;};
+
+		/**	@brief Computes the opposite modulo mod.
+		*/
+		ModInteger operator-() const;
+
+		/**	@brief Compares the values of two ModIntegers having the same modulus.
+			* @throw std::invalid_argument when moduli are different.
+		*/
+		bool operator==(const ModInteger & n) const;
+
+		/**	@brief Computes the current ModInteger to the exponent exp through sliding
+			*	window exponentiation.
+			* @throw std::bad_alloc on memory allocation error
+			* @throw std::invalid_argument when exp is negative.
+		*/
+		ModInteger pow(const Integer & exp) const;
+
+		/**	@brief Computes the modular inverse, so (*this) * inverse() = 1. The
+			*	value is converted back into Integer and inverted by Integer::invert.
+			* @throw std::bad_alloc on memory allocation error
+			* @throw std::invalid_argument when the value has no inverse, that is
+			*		when it is not coprime with the modulus.
+		*/
+		ModInteger inverse() const;
+
+	private:
+		std::shared_ptr<const Integer::MontgomeryContext> _montgomery;	///<- Context on odd moduli
+		std::shared_ptr<const Integer::BarrettContext> _barrett;				///<- Context on even moduli
+		std::vector<int32_t> _words;	///<- n words of the value: Montgomery form on odd moduli, reduced value on even ones
+
+		/**	@brief Gets the words of the modulus.
+		*/
+		const int32_t * modulus_words() const;
+
+		/**	@brief Sets the words from value, reduced and taken into Montgomery form
+			*	when required.
+		*/
+		void load(const Integer & value);
+
+		/**	@brief Checks n has the same modulus as the current ModInteger.
+			* @throw std::invalid_argument when moduli are different.
+		*/
+		void check_modulus(const ModInteger & n) const;
+};
+
 /////	Literal	/////
 
 /** Template used for determining in a static way whether an Integer literal
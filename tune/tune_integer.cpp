@@ -0,0 +1,238 @@
+/**
+ *	@brief Integer thresholds tuning tool
+ *
+ *	Benchmarks every algorithm tier of the Integer class across operand sizes
+ *	on the host CPU and writes the crossover points found into a thresholds
+ *	file. The file can be applied at runtime through Integer::load_thresholds.
+ *
+ *	Usage: tune_integer [output file]
+ *		Default output file is integer_thresholds.cfg
+ */
+#include <integer/integer.hpp>
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+
+/**
+	*	@brief Measures the time taken by a single call to f. f is run repeatedly
+	*	for 10 ms at least and the best of five rounds is kept.
+	*	@return Seconds per call.
+*/
+template <class F>
+double measure(const F & f) {
+
+	double best = -1;
+
+	for (size_t round = 0; round < 5; round++) {
+		size_t calls = 0;
+		const auto start = std::chrono::steady_clock::now();
+		double elapsed;
+
+		do {
+			f();
+			calls++;
+			elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		} while (elapsed < 0.01);
+
+		if (best < 0 || elapsed / calls < best)
+			best = elapsed / calls;
+	}
+
+	return best;
+}
+
+/**
+	*	@brief Generates a random Integer having exactly n_words words.
+*/
+Integer random_words(size_t n_words) {
+	const size_t n_bits = N_BITS_PER_WORD * n_words;
+	return Integer::rand(n_bits) | (Integer(1) << (n_bits - 1));
+}
+
+/**
+	*	@brief Finds the smallest size in [min_size, max_size] from which the
+	*	second algorithm tier is faster than the first one on three consecutive
+	*	sizes. Sizes grow geometrically.
+	*
+	*	@param name Threshold name (for progress report)
+	*	@param first Function setting up the thresholds to run the first tier on
+	*		the given size.
+	*	@param second Function setting up the thresholds to run the second tier
+	*		on the given size.
+	*	@param run Function running the operation for the given size.
+	*	@return Crossover size, or max_size when the second tier never wins.
+*/
+template <class SETUP_1, class SETUP_2, class RUN>
+size_t crossover(const std::string & name, size_t min_size, size_t max_size,
+									const SETUP_1 & first, const SETUP_2 & second, const RUN & run) {
+
+	const Integer::Thresholds org(Integer::get_thresholds());
+	size_t candidate = 0, wins = 0;
+
+	std::cout << name << std::endl;
+
+	for (size_t n = min_size; n <= max_size; n = MAX(n + 1, n * 115 / 100)) {
+
+		first(n);
+		const double t1 = measure([&]() {run(n);});
+
+		second(n);
+		const double t2 = measure([&]() {run(n);});
+
+		Integer::set_thresholds(org);
+
+		std::cout << "  " << n << " words: " << t1 * 1e6 << " us vs " << t2 * 1e6 << " us" << std::endl;
+
+		if (t2 < t1) {
+			if (wins == 0)
+				candidate = n;
+
+			if (++wins == 3)
+				return candidate;
+		}
+		else
+			wins = 0;
+	}
+
+	return max_size;
+}
+
+int main(int argc, char ** argv) {
+
+	const std::string filename(argc > 1? argv[1] : "integer_thresholds.cfg");
+	const size_t never = SIZE_MAX / 4;
+	Integer::Thresholds tuned;
+
+	Integer a, b, r;
+	size_t n_words = 0;
+
+	// Operands are generated once per size
+	auto operands = [&](size_t n) {
+		if (n != n_words) {
+			a = random_words(n);
+			b = random_words(n);
+			n_words = n;
+		}
+	};
+
+	auto multiply = [&](size_t n) {
+		operands(n);
+		r = a * b;
+	};
+
+	auto set = [&](size_t karatsuba, size_t ntt, size_t short_product) {
+		Integer::Thresholds t(tuned);
+		t.karatsuba_multiply = karatsuba;
+		t.ntt_multiply = ntt;
+		t.short_product = short_product;
+		Integer::set_thresholds(t);
+	};
+
+	// Schoolbook vs Karatsuba multiplication
+	tuned.karatsuba_multiply = crossover("karatsuba_multiply", 4, 400,
+		[&](size_t n) {set(n + 1, never, tuned.short_product);},
+		[&](size_t n) {set(n, never, tuned.short_product);}, multiply);
+	Integer::set_thresholds(tuned);
+
+	// Karatsuba vs NTT multiplication. NTT is only selected above the Karatsuba threshold
+	tuned.ntt_multiply = crossover("ntt_multiply", tuned.karatsuba_multiply + 1, 20000,
+		[&](size_t) {set(tuned.karatsuba_multiply, never, tuned.short_product);},
+		[&](size_t n) {set(tuned.karatsuba_multiply, n, tuned.short_product);}, multiply);
+	Integer::set_thresholds(tuned);
+
+	// Schoolbook vs Mulders' short product
+	tuned.short_product = crossover("short_product", 8, 2000,
+		[&](size_t n) {set(tuned.karatsuba_multiply, tuned.ntt_multiply, n + 1);},
+		[&](size_t n) {set(tuned.karatsuba_multiply, tuned.ntt_multiply, n);},
+		[&](size_t n) {
+			operands(n);
+			r = Integer::mul_low(a, b, n);
+		});
+	Integer::set_thresholds(tuned);
+
+	// NTT block size, the fastest one on a 2^18 points transform
+	std::cout << "ntt_block" << std::endl;
+	operands(1 << 17);
+
+	double best = -1;
+	for (size_t block = 1 << 10; block <= 1 << 16; block <<= 1) {
+		Integer::Thresholds t(tuned);
+		t.ntt_block = block;
+		t.ntt_parallel = never;
+		Integer::set_thresholds(t);
+
+		const double time = measure([&]() {r = a * b;});
+		std::cout << "  " << block << " points: " << time * 1e6 << " us" << std::endl;
+
+		if (best < 0 || time < best) {
+			best = time;
+			tuned.ntt_block = block;
+		}
+	}
+	Integer::set_thresholds(tuned);
+
+	// Single thread vs multithreaded NTT
+	tuned.ntt_parallel = never;
+
+	if (Integer::get_n_threads() > 1) {
+		const size_t n_threads = Integer::get_n_threads();
+
+		// Transforms of every length are split, so only the number of threads
+		// differs between both runs
+		Integer::Thresholds t(tuned);
+		t.ntt_parallel = 1;
+		Integer::set_thresholds(t);
+
+		size_t length = crossover("ntt_parallel", tuned.ntt_multiply, 1 << 18,
+			[&](size_t) {Integer::set_n_threads(1);},
+			[&](size_t) {Integer::set_n_threads(n_threads);}, multiply);
+
+		Integer::set_n_threads(n_threads);
+
+		// Threshold is given as transform length
+		tuned.ntt_parallel = 1;
+		while (tuned.ntt_parallel < 2 * length)
+			tuned.ntt_parallel <<= 1;
+	}
+	Integer::set_thresholds(tuned);
+
+	// Lehmer's gcd vs half-GCD, once the multiplication thresholds are tuned
+	auto set_hgcd = [&](size_t hgcd) {
+		Integer::Thresholds t(tuned);
+		t.hgcd = hgcd;
+		Integer::set_thresholds(t);
+	};
+
+	tuned.hgcd = crossover("hgcd", 256, 20000,
+		[&](size_t) {set_hgcd(never);},
+		[&](size_t n) {set_hgcd(n);},
+		[&](size_t n) {
+			operands(n);
+			r = Integer::gcd(a, b);
+		});
+	Integer::set_thresholds(tuned);
+
+	// Write thresholds file
+	std::ofstream file(filename);
+
+	if (!file) {
+		std::cerr << "Cannot write " << filename << std::endl;
+		return 1;
+	}
+
+	file << "# Integer thresholds generated by tune_integer on "
+				<< std::thread::hardware_concurrency() << " hardware threads\n"
+				<< "# Apply them through Integer::load_thresholds(\"" << filename << "\")\n"
+				<< "karatsuba_multiply " << tuned.karatsuba_multiply << '\n'
+				<< "ntt_multiply " << tuned.ntt_multiply << '\n'
+				<< "ntt_parallel " << tuned.ntt_parallel << '\n'
+				<< "ntt_block " << tuned.ntt_block << '\n'
+				<< "short_product " << tuned.short_product << '\n'
+				<< "hgcd " << tuned.hgcd << '\n';
+
+	std::cout << "Thresholds written to " << filename << std::endl;
+
+	return 0;
+}
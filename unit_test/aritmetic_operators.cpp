@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <list>
+#include <fstream>
+#include <cstdio>
+#include <thread>
 #include <integer/integer.hpp>
 
 ///////// ADD OPERATOR /////////
@@ -246,6 +249,37 @@ TEST(Increment_operator, increment_test) {
   }
 }
 
+TEST(Increment_operator, word_boundaries) {
+  /*Test increment and decrement carrying and borrowing across words and
+    changing sign
+  */
+  const Integer one(1);
+
+  for (size_t bits = 0; bits <= 31 * 6; bits++) {
+    const Integer power = one << bits;
+    const std::list<Integer> values = {power - 1, power, -power, -power - 1,
+                                       power - 2, -power + 1};
+
+    for (const Integer & value : values) {
+      Integer inc(value), dec(value);
+
+      EXPECT_EQ(++inc, value + 1) << "value: " << value << std::endl;
+      EXPECT_EQ(--inc, value) << "value: " << value << std::endl;
+      EXPECT_EQ(--dec, value - 1) << "value: " << value << std::endl;
+      EXPECT_EQ(++dec, value) << "value: " << value << std::endl;
+      EXPECT_EQ(inc.n_bits(), value.n_bits()) << "value: " << value << std::endl;
+    }
+  }
+
+  // Counting across zero
+  Integer counter(-1000);
+  for (long long i = -1000; i <= 1000; i++)
+    EXPECT_EQ(counter++, i);
+
+  for (long long i = 1001; i >= -1000; i--)
+    EXPECT_EQ(counter--, i);
+}
+
 ///////// DEDUCT OPERATOR /////////
 
 TEST(Deduct_operator, known_cases) {
@@ -791,6 +825,649 @@ TEST(Add_Multiply_operator, random_values) {
    }
 }
 
+TEST(Multiply_operator, ntt_big_operands) {
+  /*
+   * Test multiply operator on operands big enough to be multiplied through
+   * NTT. Let a, b, c big Integers, then (a + 1) * (a - 1) = a*a - 1 and
+   * a * (b + c) = a*b + a*c. Results must not depend on the number of threads.
+   */
+   std::default_random_engine int_gen(2611);
+   Integer::set_random_engine(int_gen);
+
+   const size_t n_threads = Integer::get_n_threads();
+   const Integer::Thresholds org = Integer::get_thresholds();
+   Integer::Thresholds ntt(org);
+   Integer a, b, c, one(1);
+
+   ntt.ntt_multiply = 64;
+   Integer::set_thresholds(ntt);
+
+   for (size_t test = 0; test < 20; test++) {
+     a = Integer::rand(20000) | (one << (size_t)20000);
+     b = Integer::rand(10000) | (one << (size_t)10000);
+     c = -Integer::rand(8000) - (one << (size_t)8000);
+
+     Integer::set_n_threads(1);
+     Integer square = a * a;
+
+     EXPECT_EQ((a + 1) * (a - 1), square - 1);
+     EXPECT_EQ(a * (b + c), a*b + a*c);
+
+     Integer::set_n_threads(4);
+     EXPECT_EQ(a * a, square);
+   }
+
+   Integer::set_thresholds(org);
+
+   // Transforms long enough to be split across threads
+   a = Integer::rand(2500000) | (one << (size_t)2500000);
+   b = Integer::rand(2400000) | (one << (size_t)2400000);
+
+   Integer::set_n_threads(1);
+   Integer product = a * b;
+
+   Integer::set_n_threads(4);
+   EXPECT_EQ(a * b, product);
+   EXPECT_EQ(b * a, product);
+
+   Integer::set_n_threads(n_threads);
+}
+
+TEST(Multiply_operator, algorithm_thresholds) {
+  /*
+   * Test multiply operator returns the same results whatever the algorithm
+   * selected by the thresholds, and thresholds can be loaded from file.
+   */
+   std::default_random_engine int_gen(2801);
+   Integer::set_random_engine(int_gen);
+
+   const Integer::Thresholds org = Integer::get_thresholds();
+   Integer::Thresholds schoolbook, karatsuba, ntt;
+
+   schoolbook.karatsuba_multiply = 100000;
+   schoolbook.ntt_multiply = 100001;
+   karatsuba.karatsuba_multiply = 2;
+   karatsuba.ntt_multiply = 100000;
+   ntt.karatsuba_multiply = 2;
+   ntt.ntt_multiply = 3;
+   ntt.ntt_block = 16;
+
+   Integer a, b, expected;
+
+   for (size_t test = 0; test < 50; test++) {
+     a = Integer::rand(8000);
+     b = -Integer::rand(5000);
+
+     Integer::set_thresholds(schoolbook);
+     expected = a * b;
+
+     Integer::set_thresholds(karatsuba);
+     EXPECT_EQ(a * b, expected);
+
+     Integer::set_thresholds(ntt);
+     EXPECT_EQ(a * b, expected);
+   }
+
+   // Non-valid thresholds are rejected
+   Integer::Thresholds wrong;
+   wrong.ntt_block = 1000;
+   EXPECT_THROW(Integer::set_thresholds(wrong), std::invalid_argument);
+
+   // Inverted multiplication tiers are rejected
+   wrong = org;
+   wrong.ntt_multiply = wrong.karatsuba_multiply;
+   EXPECT_THROW(Integer::set_thresholds(wrong), std::invalid_argument);
+
+   // Load thresholds from file
+   Integer::set_thresholds(org);
+   {
+     std::ofstream file("thresholds_test.cfg");
+     file << "# Tuned thresholds\n\nkaratsuba_multiply 40\nntt_block 1024\n";
+   }
+   Integer::load_thresholds("thresholds_test.cfg");
+   EXPECT_EQ(Integer::get_thresholds().karatsuba_multiply, 40);
+   EXPECT_EQ(Integer::get_thresholds().ntt_block, 1024);
+   EXPECT_EQ(Integer::get_thresholds().ntt_multiply, org.ntt_multiply);
+
+   {
+     std::ofstream file("thresholds_test.cfg");
+     file << "unknown_threshold 40\n";
+   }
+   EXPECT_THROW(Integer::load_thresholds("thresholds_test.cfg"), std::invalid_argument);
+   std::remove("thresholds_test.cfg");
+
+   EXPECT_THROW(Integer::load_thresholds("thresholds_test.cfg"), std::runtime_error);
+
+   Integer::set_thresholds(org);
+}
+
+TEST(Multiply_operator, karatsuba_operands) {
+  /*
+   * Test Karatsuba multiplication on balanced and unbalanced operands having
+   * every bit set (longest carries and borrows) or alternating halves.
+   */
+   const Integer::Thresholds org = Integer::get_thresholds();
+   Integer::Thresholds schoolbook, karatsuba;
+
+   schoolbook.karatsuba_multiply = 100000;
+   schoolbook.ntt_multiply = 100001;
+   karatsuba.karatsuba_multiply = 3;
+   karatsuba.ntt_multiply = 100000;
+
+   Integer one(1), expected;
+
+   for (size_t n1 : {3, 4, 7, 64, 65, 200}) {
+     for (size_t n2 : {3, 5, 64, 131, 200}) {
+       const Integer ones1 = (one << (size_t)(N_BITS_PER_WORD * n1)) - 1;
+       const Integer ones2 = (one << (size_t)(N_BITS_PER_WORD * n2)) - 1;
+       const Integer half1 = ones1 >> (size_t)(N_BITS_PER_WORD * (n1 / 2));
+       const Integer half2 = ones2 - (ones2 >> (size_t)(N_BITS_PER_WORD * (n2 / 2)));
+
+       for (const Integer & a : {ones1, half1, -ones1})
+         for (const Integer & b : {ones2, half2}) {
+           Integer::set_thresholds(schoolbook);
+           expected = a * b;
+
+           Integer::set_thresholds(karatsuba);
+           EXPECT_EQ(a * b, expected) << "Words: " << n1 << " x " << n2;
+         }
+     }
+   }
+
+   Integer::set_thresholds(org);
+}
+
+TEST(Multiply_operator, batch_multiply) {
+  /*
+   * Test batch multiplication returns the same products as the multiply
+   * operator for pairs of mixed sizes and signs, including pairs larger than
+   * the lane-parallel limit.
+   */
+   std::default_random_engine int_gen(1409);
+   Integer::set_random_engine(int_gen);
+
+   const size_t n_pairs = 203;
+   std::vector<Integer> a(n_pairs), b(n_pairs), out(n_pairs);
+
+   for (size_t i = 0; i < n_pairs; i++) {
+     a[i] = Integer::rand(1 + (i * 7) % (N_BITS_PER_WORD * (BATCH_MULTIPLY_MAX_WORDS + 2)));
+     b[i] = Integer::rand(1 + (i * 13) % (N_BITS_PER_WORD * BATCH_MULTIPLY_MAX_WORDS));
+
+     if (i % 3 == 0)
+       a[i] = -a[i];
+     if (i % 5 == 0)
+       b[i] = -b[i];
+
+     //Results must not depend on the previous content of out
+     out[i] = Integer::rand(100);
+   }
+
+   a[0] = 0;
+   b[1] = 0;
+   a[2] = (1_I << (size_t)(N_BITS_PER_WORD * BATCH_MULTIPLY_MAX_WORDS)) - 1;
+   b[2] = a[2];
+   a[3] = -(1_I << (size_t)(N_BITS_PER_WORD * BATCH_MULTIPLY_MAX_WORDS - 1));
+
+   Integer::multiply_batch(a, b, out);
+
+   for (size_t i = 0; i < n_pairs; i++)
+     EXPECT_EQ(out[i], a[i] * b[i]) << "Pair: " << i;
+
+   EXPECT_THROW(Integer::multiply_batch(a, b, std::span<Integer>(out).first(5)),
+                std::invalid_argument);
+}
+
+TEST(Multiply_operator, product_tree) {
+  /*
+   * Test product of a sequence matches the sequential product, and every
+   * product tree node is the product of its children.
+   */
+   std::default_random_engine int_gen(3011);
+   Integer::set_random_engine(int_gen);
+
+   EXPECT_EQ(Integer::product(std::vector<Integer>()), 1_I);
+   EXPECT_EQ(Integer::product(std::vector<Integer>{-7_I}), -7_I);
+   EXPECT_THROW(Integer::ProductTree(std::vector<Integer>()), std::invalid_argument);
+
+   //Factorial of 1000
+   std::vector<Integer> factors;
+   Integer expected = 1;
+
+   for (int i = 1; i <= 1000; i++) {
+     factors.push_back(i);
+     expected *= i;
+   }
+
+   EXPECT_EQ(Integer::product(factors), expected);
+
+   //Random factors with both signs, large enough to split levels across threads
+   const size_t n_threads = Integer::get_n_threads();
+
+   for (size_t threads : {1, 4}) {
+     Integer::set_n_threads(threads);
+
+     for (size_t n_factors : {2, 3, 37, 128}) {
+       factors.clear();
+       expected = 1;
+
+       for (size_t i = 0; i < n_factors; i++) {
+         factors.push_back(Integer::rand(4000));
+         if (i % 3 == 1)
+           factors.back() = -factors.back();
+         expected *= factors.back();
+       }
+
+       Integer::ProductTree tree(factors);
+
+       EXPECT_EQ(Integer::product(factors), expected) << "Factors: " << n_factors;
+       EXPECT_EQ(tree.root(), expected) << "Factors: " << n_factors;
+       ASSERT_EQ(tree.level(tree.levels() - 1).size(), 1);
+       EXPECT_EQ(tree.level(0), factors);
+
+       for (size_t i = 1; i < tree.levels(); i++) {
+         const std::vector<Integer> & children = tree.level(i - 1);
+         const std::vector<Integer> & nodes = tree.level(i);
+
+         ASSERT_EQ(nodes.size(), (children.size() + 1) / 2);
+         for (size_t j = 0; j < nodes.size(); j++)
+           EXPECT_EQ(nodes[j], 2 * j + 1 < children.size()?
+                               children[2 * j] * children[2 * j + 1] : children[2 * j]);
+       }
+     }
+   }
+
+   Integer::set_n_threads(n_threads);
+}
+
+///////// NATIVE OPERANDS /////////
+
+/**
+	* Builds the Integer equivalent to the 128 bits value of the given sign and
+	* magnitude through Integer operands only.
+*/
+static Integer wide_integer(unsigned __int128 m, bool negative) {
+  Integer r(0);
+
+  for (int shift = 120; shift >= 0; shift -= 8)
+    r = r * Integer(256) + Integer((int)((m >> shift) & 0xff));
+
+  return negative? -r : r;
+}
+
+TEST(Native_operands, wide_integral_types) {
+  /*
+   * Test add, subtract and multiply operators on unsigned long long and
+   * __int128 operands at their limits, on Integers of several sizes and
+   * signs, including carries and borrows through every word.
+   */
+   std::default_random_engine int_gen(3401);
+   Integer::set_random_engine(int_gen);
+
+   const Integer one(1);
+   std::vector<Integer> values = {0, 1, -1, INT32_MAX, INT32_MIN,
+                                  (one << (size_t)(N_BITS_PER_WORD * 6)) - 1,
+                                  -(one << (size_t)(N_BITS_PER_WORD * 6)),
+                                  -(one << (size_t)(N_BITS_PER_WORD * 6)) - 1};
+
+   for (size_t i = 0; i < 20; i++)
+     values.push_back(i % 2? Integer::rand(500) : -Integer::rand(500));
+
+   const unsigned long long ull_values[] = {0, 1, 0x7fffffffULL, 0x80000000ULL,
+                                            0xffffffffffffffffULL, 0x8000000000000000ULL};
+   const __int128 max_128 = (__int128)(((unsigned __int128)1 << 127) - 1);
+   const __int128 wide_values[] = {0, -1, max_128, -max_128 - 1,
+                                   (__int128)1 << 64, -((__int128)1 << 93) + 12345};
+
+   for (const Integer & a : values) {
+     for (unsigned long long n : ull_values) {
+       const Integer b = wide_integer(n, false);
+
+       EXPECT_EQ(a + n, a + b);
+       EXPECT_EQ(n + a, a + b);
+       EXPECT_EQ(a - n, a - b);
+       EXPECT_EQ(n - a, b - a);
+       EXPECT_EQ(a * n, a * b);
+       EXPECT_EQ(n * a, a * b);
+
+       Integer r(a);
+       r += n;
+       EXPECT_EQ(r, a + b);
+       r -= n;
+       EXPECT_EQ(r, a);
+       r *= n;
+       EXPECT_EQ(r, a * b);
+     }
+
+     for (__int128 n : wide_values) {
+       const Integer b = wide_integer(n < 0? -(unsigned __int128)n : n, n < 0);
+
+       EXPECT_EQ(a + n, a + b);
+       EXPECT_EQ(a - n, a - b);
+       EXPECT_EQ(n - a, b - a);
+       EXPECT_EQ(a * n, a * b);
+
+       Integer r(a);
+       r *= n;
+       EXPECT_EQ(r, a * b);
+     }
+   }
+}
+
+///////// FUSED MULTIPLY-ADD /////////
+
+TEST(Fused_multiply_add, integer_operands) {
+  /*
+   * Test addmul and submul accumulate the product for every sign combination
+   * and size (scalar and multi-word operands), also when the accumulator is
+   * one of the operands.
+   */
+   std::default_random_engine int_gen(3203);
+   Integer::set_random_engine(int_gen);
+
+   Integer acc, a, b, expected;
+
+   for (size_t test = 0; test < 300; test++) {
+     acc = Integer::rand(test % 7 == 0? 10 : 3000);
+     a = Integer::rand(test % 5 == 0? 62 : 2500);
+     b = Integer::rand(test % 3 == 0? 40 : 2000);
+
+     if (test % 2)
+       acc = -acc;
+     if (test % 4 >= 2)
+       a = -a;
+     if (test % 8 >= 4)
+       b = -b;
+
+     expected = acc + a * b;
+     Integer r(acc);
+     Integer::addmul(r, a, b);
+     EXPECT_EQ(r, expected);
+
+     expected = acc - a * b;
+     r = acc;
+     Integer::submul(r, a, b);
+     EXPECT_EQ(r, expected);
+
+     //Accumulator is an operand
+     expected = a + a * b;
+     r = a;
+     Integer::addmul(r, r, b);
+     EXPECT_EQ(r, expected);
+
+     expected = b - b * b;
+     r = b;
+     Integer::submul(r, r, r);
+     EXPECT_EQ(r, expected);
+   }
+
+   //Results cancelling the accumulator
+   a = Integer::rand(1000);
+   b = Integer::rand(1000);
+   acc = a * b;
+   Integer::submul(acc, a, b);
+   EXPECT_EQ(acc, 0);
+
+   acc = -(a * 7);
+   Integer::addmul(acc, a, 7);
+   EXPECT_EQ(acc, 0);
+}
+
+TEST(Fused_multiply_add, scalar_operands) {
+  /*
+   * Test addmul_ui and submul_ui accumulate the product by a 64 bits scalar.
+   */
+   std::default_random_engine int_gen(3207);
+   Integer::set_random_engine(int_gen);
+
+   const uint64_t scalars[] = {0, 1, 2, 0x7fffffff, 0x80000000, 0xffffffffffffffffULL,
+                               0x8000000000000000ULL, 12345678901234567ULL};
+   Integer acc, a, expected;
+
+   for (size_t test = 0; test < 200; test++) {
+     acc = Integer::rand(test % 3 == 0? 20 : 1500);
+     a = Integer::rand(test % 5 == 0? 31 : 1000);
+
+     if (test % 2)
+       acc = -acc;
+     if (test % 4 >= 2)
+       a = -a;
+
+     for (uint64_t m : scalars) {
+       const Integer m_value = (Integer((long long)(m >> 32)) << (size_t)32) + (long long)(m & 0xffffffff);
+
+       expected = acc + a * m_value;
+       Integer r(acc);
+       Integer::addmul_ui(r, a, m);
+       EXPECT_EQ(r, expected) << "Scalar: " << m;
+
+       expected = acc - a * m_value;
+       r = acc;
+       Integer::submul_ui(r, a, m);
+       EXPECT_EQ(r, expected) << "Scalar: " << m;
+
+       expected = a - a * m_value;
+       r = a;
+       Integer::submul_ui(r, r, m);
+       EXPECT_EQ(r, expected) << "Scalar: " << m;
+     }
+   }
+
+   //Carries through every word of the accumulator
+   const Integer one(1);
+   acc = (one << (size_t)(N_BITS_PER_WORD * 40)) - 1;
+   Integer::addmul_ui(acc, one, 1);
+   EXPECT_EQ(acc, one << (size_t)(N_BITS_PER_WORD * 40));
+   Integer::submul_ui(acc, one, 1);
+   EXPECT_EQ(acc, (one << (size_t)(N_BITS_PER_WORD * 40)) - 1);
+
+   acc = -(one << (size_t)(N_BITS_PER_WORD * 40));
+   Integer::submul_ui(acc, one, 1);
+   EXPECT_EQ(acc, -(one << (size_t)(N_BITS_PER_WORD * 40)) - 1);
+}
+
+///////// ACCUMULATOR /////////
+
+TEST(Accumulator, mixed_addends) {
+  /*
+   * Test an Accumulator sums and subtracts Integers and integral values of
+   * every sign and size.
+   */
+   std::default_random_engine int_gen(3301);
+   Integer::set_random_engine(int_gen);
+
+   Integer::Accumulator acc;
+   Integer expected;
+
+   EXPECT_EQ(acc.result(), 0);
+
+   for (size_t i = 0; i < 3000; i++) {
+     Integer n = Integer::rand(1 + (i * 37) % 2000);
+
+     if (i % 3 == 0)
+       n = -n;
+
+     if (i % 5 == 0) {
+       acc -= n;
+       expected -= n;
+     }
+     else {
+       acc += n;
+       expected += n;
+     }
+
+     const long long small = (long long)(i * 2654435761u) * (i % 2? 1 : -1);
+     acc += small;
+     expected += small;
+
+     acc += 0xffffffffffffffffULL;
+     expected += (Integer(0xffffffffLL) << (size_t)32) + 0xffffffffLL;
+
+     acc -= (long long)INT64_MIN + 1;
+     expected -= (long long)INT64_MIN + 1;
+
+     if (i % 500 == 0)
+       EXPECT_EQ(acc.result(), expected) << "Additions: " << i;
+   }
+
+   EXPECT_EQ(acc.result(), expected);
+
+   //Sums cancelling each other
+   acc.reset();
+   const Integer big = Integer::rand(5000);
+
+   acc += big;
+   acc += 7;
+   acc -= big;
+   acc -= 7;
+   EXPECT_EQ(acc.result(), 0);
+
+   acc -= 1;
+   EXPECT_EQ(acc.result(), -1);
+
+   //128 bits values out of the native range
+   const unsigned __int128 u128_max = ~(unsigned __int128)0;
+   const __int128 i128_min = (__int128)((unsigned __int128)1 << 127);
+
+   acc.reset();
+   acc += u128_max;
+   acc -= i128_min;
+   acc += i128_min;
+   EXPECT_EQ(acc.result(), (Integer(1) << (size_t)128) - 1);
+
+   acc.reset();
+   acc -= u128_max;
+   EXPECT_EQ(acc.result(), 1 - (Integer(1) << (size_t)128));
+}
+
+TEST(Accumulator, parallel_merge) {
+  /*
+   * Test Accumulators filled by several threads and merged return the sum of
+   * every value.
+   */
+   std::default_random_engine int_gen(3305);
+   Integer::set_random_engine(int_gen);
+
+   const size_t n_threads = 4, n_values = 4000;
+   std::vector<Integer> values(n_values);
+   Integer expected;
+
+   for (size_t i = 0; i < n_values; i++) {
+     values[i] = Integer::rand(800);
+     if (i % 7 < 3)
+       values[i] = -values[i];
+     expected += values[i];
+     expected += (long long)i;
+   }
+
+   std::vector<Integer::Accumulator> partial(n_threads);
+   std::vector<std::thread> threads;
+
+   for (size_t t = 0; t < n_threads; t++)
+     threads.emplace_back([&, t]() {
+       for (size_t i = t; i < n_values; i += n_threads) {
+         partial[t] += values[i];
+         partial[t] += (long long)i;
+       }
+     });
+
+   for (std::thread & thread : threads)
+     thread.join();
+
+   Integer::Accumulator total;
+   for (const Integer::Accumulator & acc : partial)
+     total.merge(acc);
+
+   EXPECT_EQ(total.result(), expected);
+
+   //Merging keeps both sums
+   total.merge(total);
+   EXPECT_EQ(total.result(), expected * 2);
+}
+
+///////// SHORT PRODUCTS /////////
+
+TEST(Short_product, low_product) {
+  /*
+   * Test low short product matches the less significant words of the full
+   * product for schoolbook and Karatsuba based sizes.
+   */
+   std::default_random_engine int_gen(2701);
+   Integer::set_random_engine(int_gen);
+
+   Integer a, b, one(1);
+
+   for (size_t n : {1, 2, 7, 31, 32, 45, 100}) {
+     const size_t n_bits = N_BITS_PER_WORD * n;
+     const Integer mask = (one << n_bits) - 1;
+
+     for (size_t test = 0; test < 10; test++) {
+       a = Integer::rand(2 * n_bits);
+       b = Integer::rand(n_bits);
+
+       EXPECT_EQ(Integer::mul_low(a, b, n), (a * b) & mask) << "Words: " << n;
+     }
+   }
+
+   EXPECT_EQ(Integer::mul_low(0_I, 15_I, 3), 0_I);
+   EXPECT_THROW(Integer::mul_low(-1_I, 15_I, 3), std::invalid_argument);
+}
+
+TEST(Short_product, high_product) {
+  /*
+   * Test high short product never exceeds the exact high words of the full
+   * product and underestimates them by 2n as max.
+   */
+   std::default_random_engine int_gen(2702);
+   Integer::set_random_engine(int_gen);
+
+   Integer a, b, exact, high;
+
+   for (size_t n : {1, 2, 7, 31, 32, 45, 100}) {
+     const size_t n_bits = N_BITS_PER_WORD * n;
+
+     for (size_t test = 0; test < 10; test++) {
+       a = Integer::rand(n_bits);
+       b = Integer::rand(n_bits);
+
+       exact = (a * b) >> n_bits;
+       high = Integer::mul_high(a, b, n);
+
+       EXPECT_LE(high, exact) << "Words: " << n;
+       EXPECT_GE(high + 2 * (long)n, exact) << "Words: " << n;
+     }
+   }
+
+   EXPECT_THROW(Integer::mul_high(1_I << (size_t)63, 15_I, 2), std::invalid_argument);
+}
+
+TEST(Short_product, middle_product) {
+  /*
+   * Test middle product adds every partial product b_j * a falling into the
+   * middle words for schoolbook and transposed Karatsuba sizes.
+   */
+   std::default_random_engine int_gen(2703);
+   Integer::set_random_engine(int_gen);
+
+   Integer a, b, expected, one(1);
+   const Integer word_mask = (one << (size_t)N_BITS_PER_WORD) - 1;
+
+   for (size_t n : {1, 2, 7, 31, 32, 45, 67}) {
+     const Integer mask = (one << N_BITS_PER_WORD * n) - 1;
+
+     for (size_t test = 0; test < 5; test++) {
+       a = Integer::rand(N_BITS_PER_WORD * (2 * n - 1));
+       b = Integer::rand(N_BITS_PER_WORD * n);
+
+       expected = 0;
+       for (size_t j = 0; j < n; j++)
+         expected += ((b >> N_BITS_PER_WORD * j) & word_mask) *
+                     ((a >> N_BITS_PER_WORD * (n - 1 - j)) & mask);
+
+       EXPECT_EQ(Integer::mul_mid(a, b, n), expected) << "Words: " << n;
+     }
+   }
+}
+
 ///////// DIVISION & MODULO OPERATOR /////////
 
 TEST(Divide_operator, zero_division) {
@@ -920,6 +1597,49 @@ TEST(Divide_operator, factorial_inverse) {
 
 }
 
+TEST(Divide_operator, long_division) {
+  /*
+   * Test quotient and remainder of random operands of many words, signs and
+   * divisors having every word but the most significant one to 0 or to 1's
+   */
+   std::default_random_engine int_gen(4242);
+   Integer::set_random_engine(int_gen);
+
+   const Integer one(1);
+   std::list<Integer> divisors;
+
+   for (size_t bits = 31; bits <= 31 * 8; bits += 31) {
+     divisors.push_back((one << bits) - 1);
+     divisors.push_back(one << (bits - 1));
+     divisors.push_back((one << bits) + 1);
+   }
+
+   for (size_t test = 0; test < 300; test++)
+     divisors.push_back(Integer::rand(int_gen() % 700 + 1) + 1);
+
+   for (const Integer & divisor : divisors) {
+     for (size_t sign = 0; sign < 4; sign++) {
+       const Integer d = sign & 1? -divisor : divisor;
+       Integer a = Integer::rand(int_gen() % 1500 + 1);
+
+       if (sign & 2)
+         a = -a;
+
+       const Integer q = a / d, r = a % d;
+
+       EXPECT_EQ(q * d + r, a) << "a: " << a << ", d: " << d << std::endl;
+       EXPECT_LT(Integer::abs(r), Integer::abs(d));
+       EXPECT_TRUE(r.is_zero() || r.is_negative() == a.is_negative());
+     }
+
+     //Dividends near multiples of the divisor
+     const Integer m = divisor * divisor;
+     EXPECT_EQ(m / divisor, divisor);
+     EXPECT_EQ((m - 1) / divisor, divisor - 1);
+     EXPECT_EQ((m - 1) % divisor, divisor - 1);
+   }
+}
+
 TEST(Divide_operator, long_long_int_right_operand) {
   /*
    * Test divide and modulo operator having long long int type at right operand
@@ -1248,6 +1968,38 @@ TEST(Power_operator, known_cases) {
    EXPECT_EQ((-36893488147419103232_I).pow(11_I), -172364133221937103085272756482216056112753534658909761028039668631756215232006744379020625060744018369805777923479247838020220755974022884986972234404720831691332769255536872593544438018353486799545737272878084128768_I);
 }
 
+TEST(Power_operator, sliding_window) {
+  /*
+   * Test power operation against repeated products, on exponents having
+   * several window sizes and bases being powers of 2
+   */
+  std::default_random_engine int_gen(4117);
+  Integer::set_random_engine(int_gen);
+
+  for (size_t i = 0; i < 20; i++) {
+    const Integer base = Integer::rand(200) * (i % 2 == 0? 1 : -1);
+    Integer expected = 1;
+
+    for (size_t e = 0; e <= 300; e++) {
+      if (e % 37 == 0 || e < 20 || e == 300)
+        EXPECT_EQ(Integer::pow(base, (Integer)e), expected);
+
+      expected *= base;
+    }
+  }
+
+  EXPECT_EQ(Integer::pow(2, 0), 1);
+  EXPECT_EQ(Integer::pow(2, 1000), 1_I << (size_t)1000);
+  EXPECT_EQ(Integer::pow(-1024, 33), -(1_I << (size_t)330));
+  EXPECT_EQ(Integer::pow(1_I << (size_t)62, 3), 1_I << (size_t)186);
+  EXPECT_EQ(Integer::pow(-1, 18446744073709551617_I), -1);
+  EXPECT_EQ(Integer::pow(-1, 18446744073709551618_I), 1);
+
+  // Exponents out of range of the result size
+  EXPECT_THROW(Integer::pow(2, 36893488147419103232_I), std::bad_alloc);
+  EXPECT_THROW(Integer::pow(3, 18446744073709551615_I), std::bad_alloc);
+}
+
 TEST(Power_operator, long_long_int_right_operand) {
   /*
    * Test power operator having long long int type as exponent
@@ -1275,3 +2027,507 @@ TEST(Power_operator, string_right_operand) {
     EXPECT_EQ((-7971_I).pow("200"),
      2007066794903987735712530422066827893429112595408742999079340652687819470957458447967655258641959403806589780369573691704347312203191133339365960951661843522209408640504669845455165346486865996223427967756581483057245991305826804142124110828963114711130880755350914315404323566437431534285443780134773141095744390708684379304491226620216814536293058000522144861958089164630852254898047531874709139051356450930984598649931798223766941251804875550927481090246088162734055828516394127127222671635439142282406624158518175559577125880384373107039713870606744081823640347256251249132242243358480716581224440986170050978940153011216961751509426660591202681636977743642498999369914737017679004413565940950540213634336558363002984198973189487435440519638352534732540489301153033805283204001_I);
 }
+
+TEST(Powmod_operation, random_values) {
+  /*
+   * Test modular power against the power reduced by repeated products, on odd
+   * and even moduli of several sizes (Montgomery reduction of Karatsuba
+   * products included)
+   */
+  std::default_random_engine int_gen(9127);
+  Integer::set_random_engine(int_gen);
+
+  for (size_t bits : {20, 100, 700, 1500, 3000}) {
+    for (size_t i = 0; i < 4; i++) {
+      Integer mod = Integer::rand(bits) + 2;
+
+      // Odd and even moduli
+      if (i % 2 == 0 && mod.is_even())
+        mod += 1;
+
+      const Integer base = Integer::rand(2 * bits) * (i < 2? 1 : -1);
+      const size_t exp = 40 + i * 17;
+
+      Integer reduced = base % mod;
+      if (reduced < 0)
+        reduced += mod;
+
+      Integer expected = 1;
+      for (size_t e = 0; e < exp; e++)
+        expected = expected * reduced % mod;
+
+      EXPECT_EQ(Integer::powmod(base, exp, mod), expected);
+      EXPECT_EQ(Integer::powmod(base, 0, mod), 1);
+    }
+  }
+
+  // Fermat's little theorem on the prime 2^127 - 1
+  const Integer p = (1_I << (size_t)127) - 1;
+  EXPECT_EQ(Integer::powmod(3, p - 1, p), 1);
+  EXPECT_EQ(Integer::powmod(-5, p, p), p - 5);
+
+  EXPECT_EQ(Integer::powmod(7, 1000, 1), 0);
+  EXPECT_EQ(Integer::powmod(3, 200, 1_I << (size_t)100), Integer::pow(3, 200) % (1_I << (size_t)100));
+
+  EXPECT_THROW(Integer::powmod(2, -1, 7), std::invalid_argument);
+  EXPECT_THROW(Integer::powmod(2, 3, -7), std::invalid_argument);
+  EXPECT_THROW(Integer::powmod(2, 3, 0), Integer::zero_division_error);
+}
+
+TEST(Powmod_operation, montgomery_context) {
+  /*
+   * Test Montgomery form conversions and products
+   */
+  const Integer mod = Integer::pow(3, 800) + 2;
+  const Integer::MontgomeryContext context(mod);
+
+  EXPECT_EQ(context.modulus(), mod);
+  EXPECT_THROW(Integer::MontgomeryContext(1_I << (size_t)100), std::invalid_argument);
+  EXPECT_THROW(Integer::MontgomeryContext(1), std::invalid_argument);
+
+  const Integer a = Integer::pow(7, 400), b = -Integer::pow(5, 500);
+  const Integer ma = context.to_montgomery(a), mb = context.to_montgomery(b);
+
+  EXPECT_EQ(context.from_montgomery(ma), a % mod);
+  EXPECT_EQ(context.from_montgomery(mb), b % mod + mod);
+  EXPECT_EQ(context.from_montgomery(context.multiply(ma, mb)), (a * b) % mod + mod);
+  EXPECT_EQ(context.power(a, 65537), Integer::powmod(a, 65537, mod));
+}
+
+TEST(Powmod_operation, barrett_context) {
+  /*
+   * Test Barrett reductions against the general division, on moduli being
+   * powers of 2^31 included
+   */
+  std::default_random_engine int_gen(5531);
+  Integer::set_random_engine(int_gen);
+
+  const Integer moduli[] = {1, 2, 1000000007, 1_I << (size_t)93, (1_I << (size_t)93) + 1,
+                            Integer::pow(10, 300) + 8, Integer::pow(6, 1200)};
+
+  for (const Integer & mod : moduli) {
+    const Integer::BarrettContext context(mod);
+    EXPECT_EQ(context.modulus(), mod);
+
+    for (size_t i = 0; i < 10; i++) {
+      const Integer a = Integer::rand(3 * mod.n_bits()) * (i % 3 == 0? -1 : 1);
+      const Integer b = Integer::rand(mod.n_bits() + 10);
+
+      Integer ra = a % mod, rb = b % mod;
+      if (ra < 0)
+        ra += mod;
+
+      EXPECT_EQ(context.reduce(a), ra);
+      EXPECT_EQ(context.mulmod(a, b), ra * rb % mod);
+      EXPECT_EQ(context.sqrmod(a), ra * ra % mod);
+      EXPECT_EQ(context.addmod(a, b), (ra + rb) % mod);
+    }
+
+    EXPECT_EQ(context.power(3, 100), Integer::pow(3, 100) % mod);
+  }
+
+  EXPECT_THROW(Integer::BarrettContext(0), Integer::zero_division_error);
+  EXPECT_THROW(Integer::BarrettContext(-10), std::invalid_argument);
+}
+
+TEST(Gcd_operation, random_values) {
+  /*
+   * Test gcd against Euclid's algorithm on remainders, on operands sharing
+   * known factors and operands of very different sizes
+   */
+  std::default_random_engine int_gen(3301);
+  Integer::set_random_engine(int_gen);
+
+  for (size_t i = 0; i < 200; i++) {
+    const Integer factor = Integer::rand(i < 100? 60 : 1500) + 1;
+    const Integer a = factor * (Integer::rand(i % 2 == 0? 2000 : 40) + 1) * (i % 3 == 0? -1 : 1);
+    const Integer b = factor * (Integer::rand(2000) + 1);
+
+    Integer x = Integer::abs(a), y = Integer::abs(b);
+    while (!y.is_zero()) {
+      const Integer r = x % y;
+      x = y;
+      y = r;
+    }
+
+    const Integer g = Integer::gcd(a, b);
+
+    EXPECT_EQ(g, x);
+    EXPECT_EQ(Integer::gcd(b, a), x);
+    EXPECT_TRUE(a % g == 0 && b % g == 0);
+  }
+
+  EXPECT_EQ(Integer::gcd(0, 0), 0);
+  EXPECT_EQ(Integer::gcd(0, -15), 15);
+  EXPECT_EQ(Integer::gcd(-12, 18), 6);
+  EXPECT_EQ(Integer::gcd(1_I << (size_t)300, 3_I << (size_t)200), 1_I << (size_t)200);
+  EXPECT_EQ(Integer::gcd(Integer::pow(2, 521) - 1, Integer::pow(2, 607) - 1), 1);
+  EXPECT_EQ(Integer::gcd(Integer::pow(6, 400), Integer::pow(15, 300)), Integer::pow(3, 300));
+}
+
+TEST(Gcd_operation, half_gcd) {
+  /*
+   * Test half-GCD against Lehmer's algorithm, lowering the hgcd threshold so
+   * the recursion is taken by medium sized operands
+   */
+  std::default_random_engine int_gen(3307);
+  Integer::set_random_engine(int_gen);
+
+  const Integer::Thresholds org = Integer::get_thresholds();
+  Integer::Thresholds hgcd(org);
+  hgcd.hgcd = 4;
+
+  for (size_t i = 0; i < 16; i++) {
+    const Integer factor = Integer::rand(i % 4 == 0? 2000 : 100) + 1;
+    const Integer a = factor * (Integer::rand(i % 2 == 0? 6000 : 4000) + 1) * (i % 3 == 0? -1 : 1);
+    const Integer b = factor * (Integer::rand(6000) + 1);
+
+    Integer::set_thresholds(org);
+    const Integer expected = Integer::gcd(a, b);
+
+    Integer::set_thresholds(hgcd);
+    EXPECT_EQ(Integer::gcd(a, b), expected);
+    EXPECT_EQ(Integer::gcd(b, a), expected);
+  }
+
+  // Consecutive Fibonacci numbers, the longest sequence of quotients
+  Integer f0 = 0, f1 = 1;
+  for (size_t i = 0; i < 10000; i++) {
+    f0 += f1;
+    std::swap(f0, f1);
+  }
+  EXPECT_EQ(Integer::gcd(f0, f1), 1);
+  EXPECT_EQ(Integer::gcd(f0 * f1, f1 * f1), f1);
+
+  Integer::set_thresholds(org);
+  EXPECT_EQ(Integer::gcd(f0 * f1, f1 * f1), f1);
+
+  hgcd.hgcd = 3;
+  EXPECT_THROW(Integer::set_thresholds(hgcd), std::invalid_argument);
+}
+
+TEST(Gcd_operation, lcm) {
+  EXPECT_EQ(Integer::lcm(4, 6), 12);
+  EXPECT_EQ(Integer::lcm(-4, 6), 12);
+  EXPECT_EQ(Integer::lcm(0, 6), 0);
+  EXPECT_EQ(Integer::lcm(Integer::pow(6, 400), Integer::pow(15, 300)),
+            Integer::pow(2, 400) * Integer::pow(3, 400) * Integer::pow(5, 300));
+}
+
+TEST(Gcd_operation, gcdext) {
+  /*
+   * Test Bezout coefficients on Lehmer's and half-GCD reductions, every sign
+   * combination and zero operands
+   */
+  std::default_random_engine int_gen(3313);
+  Integer::set_random_engine(int_gen);
+
+  const Integer::Thresholds org = Integer::get_thresholds();
+  Integer::Thresholds hgcd(org);
+  hgcd.hgcd = 4;
+
+  for (size_t i = 0; i < 40; i++) {
+    const Integer factor = Integer::rand(i % 4 == 0? 500 : 40) + 1;
+    const Integer a = factor * (Integer::rand(i % 2 == 0? 3000 : 200) + 1) * (i % 3 == 0? -1 : 1);
+    const Integer b = factor * (Integer::rand(3000) + 1) * (i % 5 == 0? -1 : 1);
+
+    Integer::set_thresholds(i < 20? org : hgcd);
+
+    Integer s, t, s_only;
+    const Integer g = Integer::gcdext(a, b, s, t);
+
+    EXPECT_EQ(g, Integer::gcd(a, b));
+    EXPECT_EQ(s * a + t * b, g);
+    EXPECT_LE(Integer::abs(s) * 2 * g, Integer::abs(b));
+    EXPECT_EQ(Integer::gcdext(a, b, s_only), g);
+    EXPECT_EQ(s_only, s);
+  }
+
+  Integer::set_thresholds(org);
+
+  Integer s, t;
+  EXPECT_EQ(Integer::gcdext(0, 0, s, t), 0);
+  EXPECT_TRUE(s == 0 && t == 0);
+  EXPECT_EQ(Integer::gcdext(-12, 0, s, t), 12);
+  EXPECT_TRUE(s == -1 && t == 0);
+  EXPECT_EQ(Integer::gcdext(0, 15, s, t), 15);
+  EXPECT_TRUE(s == 0 && t == 1);
+  EXPECT_EQ(Integer::gcdext(240, 46, s, t), 2);
+  EXPECT_TRUE(s == -9 && t == 47);
+}
+
+TEST(Gcd_operation, invert) {
+  /*
+   * Test modular inverses on prime and composite moduli, negative values and
+   * values beyond the modulus
+   */
+  std::default_random_engine int_gen(3319);
+  Integer::set_random_engine(int_gen);
+
+  const Integer moduli[] = {1000000007, (1_I << (size_t)521) - 1, Integer::pow(10, 300) + 1};
+
+  for (const Integer & m : moduli)
+    for (size_t i = 0; i < 20; i++) {
+      const Integer a = Integer::rand(i % 2 == 0? 2 * m.n_bits() : m.n_bits()) * (i % 3 == 0? -1 : 1);
+
+      if (Integer::gcd(a, m) != 1) {
+        EXPECT_THROW(Integer::invert(a, m), std::invalid_argument);
+        continue;
+      }
+
+      const Integer x = Integer::invert(a, m);
+      Integer r = a * x % m;
+      if (r < 0)
+        r += m;
+
+      EXPECT_TRUE(x >= 0 && x < m);
+      EXPECT_EQ(r, 1);
+    }
+
+  EXPECT_EQ(Integer::invert(3, 7), 5);
+  EXPECT_EQ(Integer::invert(-3, 7), 2);
+  EXPECT_EQ(Integer::invert(5, 1), 0);
+  EXPECT_THROW(Integer::invert(6, 9), std::invalid_argument);
+  EXPECT_THROW(Integer::invert(3, -7), std::invalid_argument);
+  EXPECT_THROW(Integer::invert(3, 0), Integer::zero_division_error);
+}
+
+TEST(Gcd_operation, invert_batch) {
+  /*
+   * Test batch inversion against single inversions, on single and multiple
+   * threads, and non invertible values
+   */
+  std::default_random_engine int_gen(3323);
+  Integer::set_random_engine(int_gen);
+
+  const size_t n_threads = Integer::get_n_threads();
+  const Integer moduli[] = {1000000007, (1_I << (size_t)521) - 1, 1_I << (size_t)2000};
+
+  for (const Integer & m : moduli)
+    for (size_t threads : {(size_t)1, (size_t)4}) {
+      Integer::set_n_threads(threads);
+
+      std::vector<Integer> values(300), expected(300);
+      for (size_t i = 0; i < values.size(); i++) {
+        values[i] = (2 * Integer::rand(i % 2 == 0? 2 * m.n_bits() : m.n_bits()) + 1) * (i % 3 == 0? -1 : 1);
+        expected[i] = Integer::invert(values[i], m);
+      }
+
+      Integer::invert_batch(values, m);
+      EXPECT_EQ(values, expected);
+    }
+
+  Integer::set_n_threads(n_threads);
+
+  std::vector<Integer> values = {3, 5, 6, 7};
+  EXPECT_THROW(Integer::invert_batch(values, 9), std::invalid_argument);
+  EXPECT_EQ(values, std::vector<Integer>({3, 5, 6, 7}));
+
+  values.pop_back();
+  values[2] = 0;
+  EXPECT_THROW(Integer::invert_batch(values, 11), std::invalid_argument);
+
+  values = {3};
+  Integer::invert_batch(values, 7);
+  EXPECT_EQ(values[0], 5);
+
+  values = {5, 7, -3};
+  Integer::invert_batch(values, 1);
+  EXPECT_EQ(values, std::vector<Integer>({0, 0, 0}));
+  EXPECT_EQ(Integer::invert(5, 1), 0);
+
+  values.clear();
+  EXPECT_NO_THROW(Integer::invert_batch(values, 7));
+  EXPECT_THROW(Integer::invert_batch(values, 0), Integer::zero_division_error);
+}
+
+TEST(Sqrt_operation, random_values) {
+  /*
+   * Test square roots and remainders on random values, exact squares and
+   * their neighbours, over native and recursive sizes
+   */
+  std::default_random_engine int_gen(3329);
+  Integer::set_random_engine(int_gen);
+
+  for (size_t i = 0; i < 100; i++) {
+    const Integer n = Integer::rand(i < 50? 64 : 20000);
+    Integer r;
+    const Integer s = Integer::sqrtrem(n, r);
+
+    EXPECT_EQ(s * s + r, n);
+    EXPECT_TRUE(r >= 0 && r <= 2 * s);
+    EXPECT_EQ(Integer::sqrt(n), s);
+
+    const Integer root = Integer::rand(i < 50? 32 : 10000) + 1;
+    const Integer square = root * root;
+
+    EXPECT_EQ(Integer::sqrtrem(square, r), root);
+    EXPECT_EQ(r, 0);
+    EXPECT_EQ(Integer::sqrtrem(square - 1, r), root - 1);
+    EXPECT_EQ(r, 2 * root - 2);
+    EXPECT_EQ(Integer::sqrt(square + 2 * root), root);
+  }
+
+  EXPECT_EQ(Integer::sqrt(0), 0);
+  EXPECT_EQ(Integer::sqrt(1), 1);
+  EXPECT_EQ(Integer::sqrt(Integer::pow(10, 1000)), Integer::pow(10, 500));
+  EXPECT_EQ(Integer::sqrt(Integer::pow(10, 1000) - 1), Integer::pow(10, 500) - 1);
+  EXPECT_EQ(Integer::sqrt((1_I << (size_t)128) - 1), (1_I << (size_t)64) - 1);
+  EXPECT_THROW(Integer::sqrt(-4), std::invalid_argument);
+}
+
+TEST(Sqrt_operation, is_perfect_square) {
+  /*
+   * Test perfect square detection against the remainder of the root
+   */
+  std::default_random_engine int_gen(3331);
+  Integer::set_random_engine(int_gen);
+
+  for (size_t i = 0; i < 200; i++) {
+    const Integer root = Integer::rand(i < 100? 30 : 3000);
+    const Integer n = Integer::rand(i < 100? 60 : 6000);
+    Integer r;
+    Integer::sqrtrem(n, r);
+
+    EXPECT_TRUE(Integer::is_perfect_square(root * root));
+    EXPECT_EQ(Integer::is_perfect_square(n), r == 0);
+    EXPECT_FALSE(Integer::is_perfect_square(root * root + 2 * root + 2));
+  }
+
+  EXPECT_TRUE(Integer::is_perfect_square(0));
+  EXPECT_TRUE(Integer::is_perfect_square(1));
+  EXPECT_FALSE(Integer::is_perfect_square(2));
+  EXPECT_FALSE(Integer::is_perfect_square(-4));
+  EXPECT_TRUE(Integer::is_perfect_square(Integer::pow(3, 4000)));
+  EXPECT_FALSE(Integer::is_perfect_square(Integer::pow(3, 4001)));
+}
+
+TEST(Root_operation, iroot) {
+  /*
+   * Test k-th roots on random values and exact powers and their neighbours,
+   * over native and Newton sizes
+   */
+  std::default_random_engine int_gen(3343);
+  Integer::set_random_engine(int_gen);
+
+  for (size_t i = 0; i < 60; i++) {
+    const size_t k = 1 + i % 12;
+    const Integer n = Integer::rand(i < 30? 64 : 6000);
+    const Integer r = Integer::iroot(n, k);
+
+    EXPECT_TRUE(Integer::pow(r, k) <= n && Integer::pow(r + 1, k) > n);
+
+    const Integer root = Integer::rand(i < 30? 64 / k : 6000 / k) + 2;
+    const Integer power = Integer::pow(root, k);
+
+    EXPECT_EQ(Integer::iroot(power, k), root);
+    EXPECT_EQ(Integer::iroot(power - 1, k), root - 1);
+    EXPECT_EQ(Integer::iroot(power + 1, k), k == 1? root + 1 : root);
+
+    if (k % 2 == 1)
+      EXPECT_EQ(Integer::iroot(-power, k), -root);
+  }
+
+  EXPECT_EQ(Integer::iroot(0, 5), 0);
+  EXPECT_EQ(Integer::iroot(1, 100), 1);
+  EXPECT_EQ(Integer::iroot(Integer::pow(10, 300), 1000), 1);
+  EXPECT_EQ(Integer::iroot(Integer::pow(10, 300), 3), Integer::pow(10, 100));
+  EXPECT_EQ(Integer::iroot(-27, 3), -3);
+  EXPECT_THROW(Integer::iroot(-16, 4), std::invalid_argument);
+  EXPECT_THROW(Integer::iroot(16, 0), std::invalid_argument);
+}
+
+TEST(Root_operation, is_perfect_power) {
+  /*
+   * Test perfect power detection on powers of prime and composite exponents,
+   * their neighbours and negative values
+   */
+  std::default_random_engine int_gen(3347);
+  Integer::set_random_engine(int_gen);
+
+  for (size_t i = 0; i < 40; i++) {
+    const size_t b = 2 + i % 9;
+    const Integer a = Integer::rand(i < 20? 20 : 400) + 2;
+    const Integer power = Integer::pow(a, b);
+
+    EXPECT_TRUE(Integer::is_perfect_power(power));
+    // Negative powers need an odd factor on the exponent
+    EXPECT_EQ(Integer::is_perfect_power(-power), (b & (b - 1)) != 0);
+  }
+
+  EXPECT_TRUE(Integer::is_perfect_power(0));
+  EXPECT_TRUE(Integer::is_perfect_power(1));
+  EXPECT_TRUE(Integer::is_perfect_power(-1));
+  EXPECT_TRUE(Integer::is_perfect_power(1_I << (size_t)97));
+  EXPECT_TRUE(Integer::is_perfect_power(Integer::pow(6, 35)));
+  EXPECT_TRUE(Integer::is_perfect_power(-Integer::pow(10, 9)));
+  EXPECT_TRUE(Integer::is_perfect_power(Integer::pow(3, 1009)));
+  EXPECT_TRUE(Integer::is_perfect_power(-Integer::pow(12345678901_I, 97)));
+  EXPECT_FALSE(Integer::is_perfect_power(Integer::pow(3, 1009) + 2));
+  EXPECT_FALSE(Integer::is_perfect_power(2));
+  EXPECT_FALSE(Integer::is_perfect_power(-4));
+  EXPECT_FALSE(Integer::is_perfect_power(Integer::pow(6, 35) + 1));
+  EXPECT_FALSE(Integer::is_perfect_power(Integer::pow(2, 100) * 3));
+  EXPECT_FALSE(Integer::is_perfect_power(Integer::pow(2, 400) * Integer::pow(3, 401)));
+  EXPECT_FALSE(Integer::is_perfect_power((1_I << (size_t)521) - 1));
+}
+
+TEST(ModInteger, arithmetic) {
+  /*
+   * Test modular operations against Integer operations reduced, on odd
+   * (Montgomery form) and even (Barrett) moduli
+   */
+  std::default_random_engine int_gen(2671);
+  Integer::set_random_engine(int_gen);
+
+  const Integer moduli[] = {2, 3, 1000000007, (1_I << (size_t)127) - 1, 1_I << (size_t)124,
+                            Integer::pow(3, 900) + 2, Integer::pow(3, 900) + 3};
+
+  for (const Integer & mod : moduli) {
+    const ModInteger zero(mod);
+
+    for (size_t i = 0; i < 10; i++) {
+      const Integer a = Integer::rand(2 * mod.n_bits()) * (i % 2 == 0? 1 : -1);
+      const Integer b = Integer::rand(mod.n_bits());
+
+      Integer ra = a % mod, rb = b % mod;
+      if (ra < 0)
+        ra += mod;
+
+      const ModInteger ma(a, zero), mb(b, zero);
+
+      EXPECT_EQ(ma.value(), ra);
+      EXPECT_EQ((ma + mb).value(), (ra + rb) % mod);
+      EXPECT_EQ((ma - mb).value(), (ra - rb + mod) % mod);
+      EXPECT_EQ((ma * mb).value(), ra * rb % mod);
+      EXPECT_EQ((-ma).value(), (mod - ra) % mod);
+      EXPECT_EQ(ma.pow(37).value(), Integer::powmod(ra, 37, mod));
+      EXPECT_TRUE(ma * mb == mb * ma);
+
+      // Values constructed with their own context of the same modulus
+      EXPECT_TRUE(ModInteger(a, mod) + mb == ma + mb);
+    }
+  }
+
+  EXPECT_THROW(ModInteger(1), std::invalid_argument);
+  EXPECT_THROW(ModInteger(3, 7) + ModInteger(3, 11), std::invalid_argument);
+}
+
+TEST(ModInteger, inverse) {
+  /*
+   * Test modular inverses and non invertible values
+   */
+  const Integer p = (1_I << (size_t)127) - 1;
+  const ModInteger one(1, p);
+
+  for (size_t i = 1; i < 50; i++) {
+    const ModInteger a(Integer::pow(3, 10 * i) + i, one);
+    EXPECT_TRUE(a * a.inverse() == one);
+  }
+
+  const ModInteger x(7, 1_I << (size_t)100);
+  EXPECT_EQ((x * x.inverse()).value(), 1);
+
+  EXPECT_THROW(ModInteger(6, 1_I << (size_t)100).inverse(), std::invalid_argument);
+  EXPECT_THROW(ModInteger(0, 17).inverse(), std::invalid_argument);
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <map>
 #include <integer/integer.hpp>
 
 ///////// COMPARISON OPERATORS /////////
@@ -507,3 +508,66 @@ TEST(Not_Equal_operator, string_left_operand) {
    EXPECT_EQ("-47981361310364676115367487" != 115366464131313543543_I, true);
    EXPECT_EQ("-47981361310364676115367487" != -115366464131313543543_I, true);
 }
+
+TEST(Three_way_operator, ordering) {
+  /*
+   * Test three-way comparison operator returns the ordering of Integers,
+   * integral type integers (on both sides) and strings, including strings out
+   * of the 128 bits range compared with and without a computed decimal
+   * representation.
+   */
+   EXPECT_EQ(5_I <=> 3_I, std::strong_ordering::greater);
+   EXPECT_EQ(-5_I <=> 3_I, std::strong_ordering::less);
+   EXPECT_EQ(0_I <=> 0_I, std::strong_ordering::equal);
+
+   EXPECT_EQ(4294967295_I <=> 4294967295LL, std::strong_ordering::equal);
+   EXPECT_EQ(-4294967296_I <=> -4294967295LL, std::strong_ordering::less);
+   EXPECT_EQ(7 <=> -7_I, std::strong_ordering::greater);
+   EXPECT_EQ(18446744073709551615_I <=> 18446744073709551615ULL, std::strong_ordering::equal);
+   EXPECT_EQ(18446744073709551616_I <=> 18446744073709551615ULL, std::strong_ordering::greater);
+   EXPECT_EQ(-2147483648_I <=> INT32_MIN, std::strong_ordering::equal);
+   EXPECT_EQ(-2147483649_I <=> INT32_MIN, std::strong_ordering::less);
+   EXPECT_EQ(-9223372036854775808_I <=> INT64_MIN, std::strong_ordering::equal);
+   EXPECT_EQ(85070591730234615865843651857942052864_I <=> INT64_MAX, std::strong_ordering::greater);
+   EXPECT_EQ(-85070591730234615865843651857942052864_I <=> INT64_MIN, std::strong_ordering::less);
+
+   EXPECT_EQ(137879131303364876841303_I <=> "137879131303364876841303", std::strong_ordering::equal);
+   EXPECT_EQ(137879131303364876841303_I <=> "-137879131303364876841303", std::strong_ordering::greater);
+   EXPECT_EQ("000137879131303364876841304" <=> 137879131303364876841303_I, std::strong_ordering::greater);
+   EXPECT_EQ(0_I <=> "-0", std::strong_ordering::equal);
+   EXPECT_EQ(0_I <=> "", std::strong_ordering::equal);
+   EXPECT_THROW((void)(0_I < "12a"), std::invalid_argument);
+
+   // Strings out of the 128 bits range
+   const std::string big("-1234567890123456789012345678901234567890123456789012345678901234567890");
+   Integer a(big), b(a - 1), c(a + 1);
+
+   for (size_t cached = 0; cached < 2; cached++) {
+     if (cached) {
+       a.getString();
+       b.getString();
+       c.getString();
+     }
+
+     EXPECT_EQ(a <=> big, std::strong_ordering::equal);
+     EXPECT_EQ(b <=> big, std::strong_ordering::less);
+     EXPECT_EQ(c <=> big, std::strong_ordering::greater);
+     EXPECT_EQ(big <=> b, std::strong_ordering::greater);
+     EXPECT_TRUE(a == big);
+     EXPECT_TRUE(-a > big);
+     EXPECT_TRUE(a * a > big.substr(1));
+     EXPECT_TRUE(1_I > big);
+     EXPECT_TRUE(0_I > big);
+   }
+
+   // Ordered containers use the derived less than operator
+   std::map<Integer, int> keys;
+   keys[c] = 3;
+   keys[a] = 2;
+   keys[b] = 1;
+   keys[5] = 4;
+
+   int expected = 1;
+   for (const auto & key : keys)
+     EXPECT_EQ(key.second, expected++);
+}
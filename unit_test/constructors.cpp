@@ -3,6 +3,8 @@
 #include <limits>
 #include <string>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 #include <integer/integer.hpp>
 
 TEST(Constructor, Empty_constructor) {
@@ -132,3 +134,68 @@ TEST(Constructor, literal_constructor) {
         EXPECT_EQ(*it, Integer(*jt));
       }
 }
+
+TEST(Constructor, copy_on_write) {
+  Integer modulus = Integer::pow(3, 5000) - 1;
+  const Integer value = modulus;
+
+  EXPECT_FALSE(modulus.is_shared());
+  modulus.share();
+  EXPECT_TRUE(modulus.is_shared());
+  EXPECT_EQ(modulus, value);
+
+  // Copies share the words
+  Integer copy1(modulus), copy2;
+  copy2 = copy1;
+  EXPECT_TRUE(copy1.is_shared());
+  EXPECT_TRUE(copy2.is_shared());
+
+  // Only the writer clones them
+  copy1 += 1;
+  EXPECT_FALSE(copy1.is_shared());
+  EXPECT_EQ(copy1, value + 1);
+  EXPECT_TRUE(copy2.is_shared());
+  EXPECT_EQ(copy2, value);
+  EXPECT_EQ(modulus, value);
+
+  copy2 >>= (size_t)100;
+  EXPECT_EQ(copy2, value >> (size_t)100);
+  copy2 = -modulus;
+  EXPECT_TRUE(copy2.is_shared());
+  copy2 *= modulus;
+  EXPECT_EQ(copy2, -(value * value));
+  EXPECT_EQ(modulus, value);
+
+  // Whole value overwrites release the shared words
+  Integer copy3 = modulus;
+  copy3 /= value + 1;
+  EXPECT_FALSE(copy3.is_shared());
+  EXPECT_EQ(copy3, 0);
+  copy3 = modulus;
+  copy3 >>= (size_t)(modulus.n_bits() - 1);
+  EXPECT_EQ(copy3, 1);
+  EXPECT_TRUE(modulus.is_shared());
+  EXPECT_EQ(modulus, value);
+
+  // Concurrent readers copying and reading the shared words
+  std::vector<std::thread> threads;
+  std::vector<Integer> results(4);
+
+  for (size_t t = 0; t < results.size(); t++)
+    threads.emplace_back([&modulus, &results, t]() {
+      for (size_t i = 0; i < 100; i++) {
+        Integer copy = modulus;
+        copy -= t;
+        results[t] = copy % 1000000007;
+      }
+    });
+
+  for (std::thread & thread : threads)
+    thread.join();
+
+  for (size_t t = 0; t < results.size(); t++)
+    EXPECT_EQ(results[t], (value - t) % 1000000007);
+
+  EXPECT_TRUE(modulus.is_shared());
+  EXPECT_EQ(modulus, value);
+}
@@ -96,3 +96,33 @@ TEST(Extractor_Insertor_operator, random_values) {
 
   f.close();
 }
+
+TEST(Extractor_Insertor_operator, decimal_chunks) {
+  /*
+   * Test decimal conversion of values whose 9 digits chunks are zero, short
+   * or full of nines
+  */
+  const std::list<std::string> sample = {"1000000000", "-1000000000", "999999999",
+                                         "1000000000000000000", "-999999999999999999",
+                                         "1000000000000000000000000000000000000000000000001",
+                                         "-100000000900000000070000000000000000000",
+                                         "999999999999999999999999999999999999999999999999999"};
+
+  for (const std::string & digits : sample) {
+    const Integer n(digits);
+    EXPECT_EQ(n.getString(), digits);
+    EXPECT_EQ(Integer(n.getString()), n);
+  }
+
+  // Powers of ten crossing words boundaries
+  Integer power(1);
+  std::string expected("1");
+
+  for (size_t i = 0; i < 200; i++) {
+    EXPECT_EQ(power.getString(), expected);
+    EXPECT_EQ(Integer(expected), power);
+
+    power *= 10;
+    expected += '0';
+  }
+}
@@ -603,3 +603,46 @@ TEST(Shift_right_assignment, known_cases) {
    EXPECT_EQ(n >>= (size_t)62, -19807040628566084398385987584_I);
    EXPECT_EQ(n, -19807040628566084398385987584_I);
 }
+
+///////// TWO'S COMPLEMENT SEMANTICS /////////
+
+TEST(Bitwise_operators, twos_complement_semantics) {
+  /*
+   * Test bitwise operators on mixed sign operands behave as on native two's
+   * complement integers, operands crossing words boundaries
+   */
+   std::mt19937_64 gen(3517);
+
+   for (size_t test = 0; test < 20000; test++) {
+     const size_t bits_a = gen() % 120 + 1, bits_b = gen() % 120 + 1;
+     __int128 a = ((__int128)gen() << 64 | gen()) >> (128 - bits_a);
+     __int128 b = ((__int128)gen() << 64 | gen()) >> (128 - bits_b);
+
+     if (gen() % 2)
+       a = -a;
+     if (gen() % 2)
+       b = -b;
+
+     const Integer ia(a), ib(b);
+     const size_t shift = gen() % 130;
+
+     EXPECT_EQ(ia & ib, Integer(a & b));
+     EXPECT_EQ(ia | ib, Integer(a | b));
+     EXPECT_EQ(~ia, Integer(~a));
+     EXPECT_EQ(ia >> shift, Integer(a >> MIN(shift, (size_t)127)));
+     EXPECT_EQ((ia << (shift % 7)) >> (shift % 7), ia);
+   }
+
+   // Absolute values multiple of the word size
+   const Integer one(1);
+
+   for (size_t bits = 1; bits < 200; bits++) {
+     const Integer power = one << bits;
+
+     EXPECT_EQ(-power & -power, -power);
+     EXPECT_EQ(-power | (power - 1), -1_I);
+     EXPECT_EQ(-power & (power - 1), 0_I);
+     EXPECT_EQ(-power >> bits, -1_I);
+     EXPECT_EQ((-power - 1) >> bits, -2_I);
+   }
+}
@@ -232,3 +232,56 @@ TEST(Access_operator, access_operator) {
     EXPECT_THROW(ti[it->size()], std::out_of_range);
   }
 }
+
+TEST(Capacity, reserve_and_shrink) {
+  Integer n(1);
+
+  n.reserve(31 * 100);
+  EXPECT_GE(n.capacity_bits(), (size_t)(31 * 100));
+
+  // Growing up to the reserved bits keeps the capacity
+  const size_t capacity = n.capacity_bits();
+
+  for (size_t i = 0; i < 3000; i++)
+    n <<= (size_t)1;
+
+  EXPECT_EQ(n.capacity_bits(), capacity);
+  EXPECT_EQ(n, Integer(1) << (size_t)3000);
+
+  // In-place products fitting in the reserved bits keep it as well
+  n = 3;
+  for (size_t i = 0; i < 8; i++)
+    n *= n;
+
+  EXPECT_EQ(n.capacity_bits(), capacity);
+  EXPECT_EQ(n, Integer::pow(3, 256));
+
+  // Capacity is released once the value is reduced
+  n = 5;
+  n.shrink_to_fit();
+  EXPECT_LT(n.capacity_bits(), capacity);
+  EXPECT_GE(n.capacity_bits(), n.n_bits());
+  EXPECT_EQ(n, 5);
+}
+
+TEST(Capacity, growth_factor) {
+  const double growth_factor = Integer::get_growth_factor();
+
+  EXPECT_THROW(Integer::set_growth_factor(0.5), std::invalid_argument);
+  EXPECT_THROW(Integer::set_growth_factor(INFINITY), std::invalid_argument);
+  EXPECT_THROW(Integer::set_growth_factor(NAN), std::invalid_argument);
+  EXPECT_EQ(Integer::get_growth_factor(), growth_factor);
+
+  Integer::set_growth_factor(4);
+
+  Integer n(1);
+  n.shrink_to_fit();
+  EXPECT_EQ(n.capacity_bits(), (size_t)31);
+
+  // Exceeding one word grows the capacity to four words
+  n <<= (size_t)31;
+  EXPECT_EQ(n.capacity_bits(), (size_t)(4 * 31));
+  EXPECT_EQ(n, 2147483648_I);
+
+  Integer::set_growth_factor(growth_factor);
+}